@@ -193,6 +193,7 @@ class Thread {
 #ifdef HAVE_ATOMIC_OPS
 #define osmo_trx_sync_fetch_and_and(ptr, value) __sync_fetch_and_and((ptr), (value))
 #define osmo_trx_sync_or_and_fetch(ptr, value) __sync_or_and_fetch((ptr), (value))
+#define osmo_trx_sync_fetch_and_add(ptr, value) __sync_fetch_and_add((ptr), (value))
 #else
 extern pthread_mutex_t atomic_ops_mutex;
 static inline int osmo_trx_sync_fetch_and_and(int *ptr, int value)
@@ -213,6 +214,15 @@ static inline int osmo_trx_sync_or_and_fetch(int *ptr, int value)
 	pthread_mutex_unlock(&atomic_ops_mutex);
 	return tmp;
 }
+
+static inline int osmo_trx_sync_fetch_and_add(int *ptr, int value)
+{
+	pthread_mutex_lock(&atomic_ops_mutex);
+	int tmp = *ptr;
+	*ptr += value;
+	pthread_mutex_unlock(&atomic_ops_mutex);
+	return tmp;
+}
 #endif
 
 #endif
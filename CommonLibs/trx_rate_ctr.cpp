@@ -76,6 +76,7 @@ static void *trx_rate_ctr_ctx;
 static struct rate_ctr_group** rate_ctrs;
 static struct device_counters* dev_ctrs_pending;
 static struct trx_counters* trx_ctrs_pending;
+static int* rx_gated_pending;
 static size_t chan_len;
 static struct osmo_fd dev_rate_ctr_timerfd;
 static struct osmo_fd trx_rate_ctr_timerfd;
@@ -103,6 +104,7 @@ const struct value_string trx_chan_ctr_names[] = {
 	{ TRX_CTR_DEV_TX_DROP_EV,	"tx_drop_events" },
 	{ TRX_CTR_DEV_TX_DROP_SMPL,	"tx_drop_samples" },
 	{ TRX_CTR_TRX_TX_STALE_BURSTS,	"tx_stale_bursts" },
+	{ TRX_CTR_TRX_RX_GATED_BURSTS,	"rx_gated_bursts" },
 	{ 0, NULL }
 };
 
@@ -114,6 +116,7 @@ static const struct rate_ctr_desc trx_chan_ctr_desc[] = {
 	[TRX_CTR_DEV_TX_DROP_EV]		= { "device:tx_drop_events",	"Number of times Tx samples were dropped by HW" },
 	[TRX_CTR_DEV_TX_DROP_SMPL]		= { "device:tx_drop_samples",	"Number of Tx samples dropped by HW" },
 	[TRX_CTR_TRX_TX_STALE_BURSTS]		= { "trx:tx_stale_bursts",	"Number of Tx burts dropped by TRX due to arriving too late" },
+	[TRX_CTR_TRX_RX_GATED_BURSTS]		= { "trx:rx_gated_bursts",	"Number of Rx bursts skipped before detection due to energy below the SNR gate" },
 };
 
 static const struct rate_ctr_group_desc trx_chan_ctr_group_desc = {
@@ -158,9 +161,13 @@ static int dev_rate_ctr_timerfd_cb(struct osmo_fd *ofd, unsigned int what) {
 static int trx_rate_ctr_timerfd_cb(struct osmo_fd *ofd, unsigned int what) {
 	size_t chan;
 	struct rate_ctr *ctr;
+	int gated;
 	LOGC(DMAIN, NOTICE) << "Main thread is updating Transceiver counters";
 	trx_rate_ctr_mutex.lock();
 	for (chan = 0; chan < chan_len; chan++) {
+		gated = osmo_trx_sync_fetch_and_and(&rx_gated_pending[chan], 0);
+		if (gated)
+			rate_ctr_add(&rate_ctrs[chan]->ctr[TRX_CTR_TRX_RX_GATED_BURSTS], gated);
 		if (trx_ctrs_pending[chan].chan == PENDING_CHAN_NONE)
 			continue;
 		LOGCHAN(chan, DMAIN, INFO) << "rate_ctr update";
@@ -175,6 +182,31 @@ static int trx_rate_ctr_timerfd_cb(struct osmo_fd *ofd, unsigned int what) {
 	return 0;
 }
 
+/* Count an Rx burst skipped by the energy gate. Called by the Rx thread for
+ * every such burst, too often to go through device_sig_cb as that would keep
+ * pushing the timerfd back. The bursts are counted atomically per channel and
+ * added to the rate counter by trx_rate_ctr_timerfd_cb, which is scheduled on
+ * the first burst counted since its last run. */
+void trx_rate_ctr_rx_gated(size_t chan)
+{
+	struct timespec next_sched = {.tv_sec = 0, .tv_nsec = 20*1000*1000};
+	struct timespec intv_sched = {.tv_sec = 0, .tv_nsec = 0};
+
+	if (chan >= chan_len)
+		return;
+
+	if (osmo_trx_sync_fetch_and_add(&rx_gated_pending[chan], 1))
+		return;
+
+	thread_enable_cancel(false);
+	trx_rate_ctr_mutex.lock();
+	if (osmo_timerfd_schedule(&trx_rate_ctr_timerfd, &next_sched, &intv_sched) < 0) {
+		LOGC(DMAIN, ERROR) << "Failed to schedule timerfd: " << errno << " = "<< strerror(errno);
+	}
+	trx_rate_ctr_mutex.unlock();
+	thread_enable_cancel(true);
+}
+
 /* Callback function to be called every time we receive a signal from DEVICE */
 static int device_sig_cb(unsigned int subsys, unsigned int signal,
 			 void *handler_data, void *signal_data)
@@ -310,6 +342,7 @@ void trx_rate_ctr_init(void *ctx, struct trx_ctx* trx_ctx)
 	chan_len = trx_ctx->cfg.num_chans;
 	dev_ctrs_pending = (struct device_counters*) talloc_zero_size(ctx, chan_len * sizeof(struct device_counters));
 	trx_ctrs_pending = (struct trx_counters*) talloc_zero_size(ctx, chan_len * sizeof(struct trx_counters));
+	rx_gated_pending = (int*) talloc_zero_size(ctx, chan_len * sizeof(int));
 	rate_ctrs = (struct rate_ctr_group**) talloc_zero_size(ctx, chan_len * sizeof(struct rate_ctr_group*));
 
 	for (i = 0; i < chan_len; i++) {
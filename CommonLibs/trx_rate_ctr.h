@@ -11,6 +11,7 @@ enum TrxCtr {
 	TRX_CTR_DEV_TX_DROP_EV,
 	TRX_CTR_DEV_TX_DROP_SMPL,
 	TRX_CTR_TRX_TX_STALE_BURSTS,
+	TRX_CTR_TRX_RX_GATED_BURSTS,
 };
 
 struct ctr_threshold {
@@ -29,3 +30,4 @@ void trx_rate_ctr_init(void *ctx, struct trx_ctx* trx_ctx);
 void trx_rate_ctr_threshold_add(struct ctr_threshold *ctr);
 int trx_rate_ctr_threshold_del(struct ctr_threshold *del_ctr);
 void trx_rate_ctr_threshold_write_config(struct vty *vty, char *indent_prefix);
+void trx_rate_ctr_rx_gated(size_t chan);
@@ -291,6 +291,78 @@ DEFUN(cfg_ext_rach, cfg_ext_rach_cmd,
 	return CMD_SUCCESS;
 }
 
+DEFUN(cfg_half_buffers, cfg_half_buffers_cmd,
+	"half-buffers (disable|enable)",
+	"Store radio sample buffers in half precision (default=disable)\n")
+{
+	struct trx_ctx *trx = trx_from_vty(vty);
+
+	if (strcmp("disable", argv[0]) == 0)
+		trx->cfg.half_buffers = false;
+
+	if (strcmp("enable", argv[0]) == 0)
+		trx->cfg.half_buffers = true;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_kernel_autotune, cfg_kernel_autotune_cmd,
+	"kernel-autotune (disable|enable)",
+	"Benchmark the convolution kernels at startup and keep the fastest (default=disable)\n")
+{
+	struct trx_ctx *trx = trx_from_vty(vty);
+
+	if (strcmp("disable", argv[0]) == 0)
+		trx->cfg.kernel_autotune = false;
+
+	if (strcmp("enable", argv[0]) == 0)
+		trx->cfg.kernel_autotune = true;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_rx_snr_gate, cfg_rx_snr_gate_cmd,
+	"rx-snr-gate <0-30>",
+	"Skip burst detection in slots below an SNR over the noise level (default=0, disabled)\n"
+	"SNR in dB\n")
+{
+	struct trx_ctx *trx = trx_from_vty(vty);
+
+	trx->cfg.rx_snr_gate = atoi(argv[0]);
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_rx_toa_track, cfg_rx_toa_track_cmd,
+	"rx-toa-track (disable|enable)",
+	"Search normal bursts on dedicated channels around the timing of the previous burst (default=disable)\n")
+{
+	struct trx_ctx *trx = trx_from_vty(vty);
+
+	if (strcmp("disable", argv[0]) == 0)
+		trx->cfg.rx_toa_track = false;
+
+	if (strcmp("enable", argv[0]) == 0)
+		trx->cfg.rx_toa_track = true;
+
+	return CMD_SUCCESS;
+}
+
+DEFUN(cfg_rx_frame_batch, cfg_rx_frame_batch_cmd,
+	"rx-frame-batch (disable|enable)",
+	"Detect the normal bursts of a TDMA frame together, at the cost of up to one frame of latency (default=disable)\n")
+{
+	struct trx_ctx *trx = trx_from_vty(vty);
+
+	if (strcmp("disable", argv[0]) == 0)
+		trx->cfg.rx_frame_batch = false;
+
+	if (strcmp("enable", argv[0]) == 0)
+		trx->cfg.rx_frame_batch = true;
+
+	return CMD_SUCCESS;
+}
+
 DEFUN(cfg_rt_prio, cfg_rt_prio_cmd,
 	"rt-prio <1-32>",
 	"Set the SCHED_RR real-time priority\n"
@@ -564,6 +636,12 @@ static int config_write_trx(struct vty *vty)
 	vty_out(vty, " swap-channels %s%s", trx->cfg.swap_channels ? "enable" : "disable", VTY_NEWLINE);
 	vty_out(vty, " egprs %s%s", trx->cfg.egprs ? "enable" : "disable", VTY_NEWLINE);
 	vty_out(vty, " ext-rach %s%s", trx->cfg.ext_rach ? "enable" : "disable", VTY_NEWLINE);
+	vty_out(vty, " half-buffers %s%s", trx->cfg.half_buffers ? "enable" : "disable", VTY_NEWLINE);
+	vty_out(vty, " kernel-autotune %s%s", trx->cfg.kernel_autotune ? "enable" : "disable", VTY_NEWLINE);
+	if (trx->cfg.rx_snr_gate != 0)
+		vty_out(vty, " rx-snr-gate %u%s", trx->cfg.rx_snr_gate, VTY_NEWLINE);
+	vty_out(vty, " rx-toa-track %s%s", trx->cfg.rx_toa_track ? "enable" : "disable", VTY_NEWLINE);
+	vty_out(vty, " rx-frame-batch %s%s", trx->cfg.rx_frame_batch ? "enable" : "disable", VTY_NEWLINE);
 	if (trx->cfg.sched_rr != 0)
 		vty_out(vty, " rt-prio %u%s", trx->cfg.sched_rr, VTY_NEWLINE);
 	if (trx->cfg.filler != FILLER_ZERO)
@@ -609,6 +687,12 @@ static void trx_dump_vty(struct vty *vty, struct trx_ctx *trx)
 	vty_out(vty, " Swap channels: %s%s", trx->cfg.swap_channels ? "Enabled" : "Disabled", VTY_NEWLINE);
 	vty_out(vty, " EDGE support: %s%s", trx->cfg.egprs ? "Enabled" : "Disabled", VTY_NEWLINE);
 	vty_out(vty, " Extended RACH support: %s%s", trx->cfg.ext_rach ? "Enabled" : "Disabled", VTY_NEWLINE);
+	vty_out(vty, " Half precision buffers: %s%s", trx->cfg.half_buffers ? "Enabled" : "Disabled", VTY_NEWLINE);
+	vty_out(vty, " Kernel autotuning: %s%s", trx->cfg.kernel_autotune ? "Enabled" : "Disabled", VTY_NEWLINE);
+	vty_out(vty, " Rx SNR gate: %u dB (%s)%s", trx->cfg.rx_snr_gate,
+		trx->cfg.rx_snr_gate ? "Enabled" : "Disabled", VTY_NEWLINE);
+	vty_out(vty, " Rx TOA tracking: %s%s", trx->cfg.rx_toa_track ? "Enabled" : "Disabled", VTY_NEWLINE);
+	vty_out(vty, " Rx frame batching: %s%s", trx->cfg.rx_frame_batch ? "Enabled" : "Disabled", VTY_NEWLINE);
 	vty_out(vty, " Real Time Priority: %u (%s)%s", trx->cfg.sched_rr,
 		trx->cfg.sched_rr ? "Enabled" : "Disabled", VTY_NEWLINE);
 	vty_out(vty, " Stack size per Thread in BYTE (0 = OS default): %u%s", trx->cfg.stack_size, VTY_NEWLINE);
@@ -634,6 +718,23 @@ DEFUN(show_trx, show_trx_cmd,
 	return CMD_SUCCESS;
 }
 
+void (*trx_vty_dump_kernels)(struct vty *vty) = NULL;
+
+DEFUN(show_trx_kernels, show_trx_kernels_cmd,
+	"show trx kernels",
+	SHOW_STR "Display information on the TRX\n"
+	"Display the convolution kernels selected by the autotuner\n")
+{
+	if (!trx_vty_dump_kernels) {
+		vty_out(vty, "%% Kernel autotuning not available%s", VTY_NEWLINE);
+		return CMD_WARNING;
+	}
+
+	trx_vty_dump_kernels(vty);
+
+	return CMD_SUCCESS;
+}
+
 static int trx_vty_is_config_node(struct vty *vty, int node)
 {
 	switch (node) {
@@ -703,6 +804,7 @@ int trx_vty_init(struct trx_ctx* trx)
 {
 	g_trx_ctx = trx;
 	install_element_ve(&show_trx_cmd);
+	install_element_ve(&show_trx_kernels_cmd);
 
 	install_element(CONFIG_NODE, &cfg_trx_cmd);
 
@@ -720,6 +822,11 @@ int trx_vty_init(struct trx_ctx* trx)
 	install_element(TRX_NODE, &cfg_swap_channels_cmd);
 	install_element(TRX_NODE, &cfg_egprs_cmd);
 	install_element(TRX_NODE, &cfg_ext_rach_cmd);
+	install_element(TRX_NODE, &cfg_half_buffers_cmd);
+	install_element(TRX_NODE, &cfg_kernel_autotune_cmd);
+	install_element(TRX_NODE, &cfg_rx_snr_gate_cmd);
+	install_element(TRX_NODE, &cfg_rx_toa_track_cmd);
+	install_element(TRX_NODE, &cfg_rx_frame_batch_cmd);
 	install_element(TRX_NODE, &cfg_rt_prio_cmd);
 	install_element(TRX_NODE, &cfg_filler_type_cmd);
 	install_element(TRX_NODE, &cfg_filler_tsc_cmd);
@@ -62,6 +62,11 @@ struct trx_ctx {
 		bool swap_channels;
 		bool ext_rach;
 		bool egprs;
+		bool half_buffers;
+		bool kernel_autotune;
+		unsigned int rx_snr_gate;
+		bool rx_toa_track;
+		bool rx_frame_batch;
 		unsigned int sched_rr;
 		unsigned int stack_size;
 		unsigned int num_chans;
@@ -69,5 +74,8 @@ struct trx_ctx {
 	} cfg;
 };
 
+/* Prints the autotuned convolution kernels, installed by the application */
+extern void (*trx_vty_dump_kernels)(struct vty *vty);
+
 int trx_vty_init(struct trx_ctx* trx);
 struct trx_ctx *vty_trx_ctx_alloc(void *talloc_ctx);
@@ -29,6 +29,7 @@
 
 #include "Logger.h"
 #include "ChannelizerBase.h"
+#include "KernelTuner.h"
 
 extern "C" {
 #include "fft.h"
@@ -203,6 +204,8 @@ bool ChannelizerBase::init()
 
 	mapBuffers();
 
+	kernelTunerShape(CONV_REAL, hLen, blockLen);
+
 	return true;
 }
 
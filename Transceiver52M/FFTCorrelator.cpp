@@ -0,0 +1,168 @@
+/*
+ * Overlap-save FFT Correlation
+ *
+ * SPDX-License-Identifier: LGPL-2.1+
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "FFTCorrelator.h"
+
+extern "C" {
+#include "fft.h"
+#include "mult.h"
+}
+
+/* Smallest FFT, also sets the overlap ratio of the taps to the transform */
+#define MIN_FFT_LEN		64
+#define FFT_TAP_RATIO		4
+
+/*
+ * Per-thread transform buffers. FFT plans are shared and executed on these
+ * buffers so that concurrent receive threads never touch the same memory.
+ */
+struct FFTScratch {
+	FFTScratch() : in(NULL), out(NULL), len(0)
+	{
+	}
+
+	~FFTScratch()
+	{
+		fft_free(in);
+		fft_free(out);
+	}
+
+	bool reserve(size_t n)
+	{
+		if (n <= len)
+			return true;
+
+		fft_free(in);
+		fft_free(out);
+		in = (float *) fft_malloc(n * sizeof(complex));
+		out = (float *) fft_malloc(n * sizeof(complex));
+		len = (in && out) ? n : 0;
+
+		return len > 0;
+	}
+
+	float *in;
+	float *out;
+	size_t len;
+};
+
+static thread_local FFTScratch scratch;
+
+FFTCorrelator::FFTCorrelator(const signalVector &h)
+	: hLen(h.size()), fftLen(MIN_FFT_LEN), blockLen(0), seq(h),
+	  taps(NULL), fwd(NULL), inv(NULL)
+{
+	while (fftLen < FFT_TAP_RATIO * hLen)
+		fftLen <<= 1;
+
+	blockLen = fftLen - hLen + 1;
+}
+
+FFTCorrelator::~FFTCorrelator()
+{
+	if (fwd)
+		free_fft(fwd);
+	if (inv)
+		free_fft(inv);
+
+	fft_free(taps);
+}
+
+bool FFTCorrelator::init()
+{
+	float *in, *out;
+	size_t size = fftLen * sizeof(complex);
+
+	if (!hLen || fwd || inv)
+		return false;
+
+	taps = (float *) fft_malloc(size);
+	if (!taps || !scratch.reserve(fftLen))
+		return false;
+
+	/* Planning may overwrite the buffers, so fill the taps afterwards */
+	in = scratch.in;
+	out = scratch.out;
+	fwd = init_fft(0, fftLen, 1, 1, in, out, 0);
+	inv = init_fft(1, fftLen, 1, 1, out, in, 0);
+	if (!fwd || !inv)
+		return false;
+
+	/*
+	 * Reverse the taps so that the correlation becomes a linear
+	 * convolution and fold the inverse transform scaling into the
+	 * frequency response.
+	 */
+	memset(in, 0, size);
+	for (size_t i = 0; i < hLen; i++) {
+		in[2 * i + 0] = seq[hLen - 1 - i].real() / fftLen;
+		in[2 * i + 1] = seq[hLen - 1 - i].imag() / fftLen;
+	}
+
+	cxvec_fft_buf(fwd, in, taps);
+
+	return true;
+}
+
+bool FFTCorrelator::correlate(const signalVector &x, signalVector &y,
+			      size_t start, size_t len)
+{
+	ssize_t head, base, xLen = x.size();
+	size_t n;
+
+	if (!taps || (len > y.size()) || !scratch.reserve(fftLen))
+		return false;
+
+	float *in = scratch.in;
+	float *out = scratch.out;
+
+	for (size_t i = 0; i < len; i += blockLen) {
+		/* Gather fftLen inputs ending at the last output, zero filled */
+		base = (ssize_t) (start + i) - (ssize_t) (hLen - 1);
+		head = std::min(std::max(-base, (ssize_t) 0), (ssize_t) fftLen);
+		n = std::max(std::min(xLen - base, (ssize_t) fftLen), head) - head;
+
+		memset(in, 0, head * sizeof(complex));
+		if (n)
+			memcpy(&in[2 * head], x.begin() + base + head,
+			       n * sizeof(complex));
+		memset(&in[2 * (head + n)], 0,
+		       (fftLen - head - n) * sizeof(complex));
+
+		cxvec_fft_buf(fwd, in, out);
+		mul_complex(out, out, taps, fftLen);
+		cxvec_fft_buf(inv, out, in);
+
+		/* Circular wrap only corrupts the first hLen - 1 samples */
+		n = std::min(blockLen, len - i);
+		memcpy((float *) y.begin() + 2 * i, &in[2 * (hLen - 1)],
+		       n * sizeof(complex));
+	}
+
+	return true;
+}
+
+size_t FFTCorrelator::len()
+{
+	return blockLen;
+}
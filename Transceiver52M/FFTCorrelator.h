@@ -0,0 +1,74 @@
+/*
+ * Overlap-save FFT Correlation
+ *
+ * SPDX-License-Identifier: LGPL-2.1+
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _FFT_CORRELATOR_H_
+#define _FFT_CORRELATOR_H_
+
+#include "signalVector.h"
+
+class FFTCorrelator {
+public:
+	/* Constructor for overlap-save correlation
+	 *   @param h correlation taps in convolve() order
+	 *
+	 * Output matches convolve() with a CUSTOM span, that is, each
+	 * output sample is the dot product of the taps with the preceding
+	 * h.size() input samples.
+	 */
+	FFTCorrelator(const signalVector &h);
+	~FFTCorrelator();
+
+	/* Create FFT plans and transform the taps
+	 *   @return false on error, true otherwise
+	 *
+	 * FFT planning is not thread-safe. Call once during setup.
+	 */
+	bool init();
+
+	/* Correlate input over a search window
+	 *   @param x input vector
+	 *   @param y output vector of at least len samples
+	 *   @param start input index of the first output sample
+	 *   @param len number of output samples
+	 *   @return false on error, true otherwise
+	 *
+	 * Input samples outside of x are treated as zero. May be called
+	 * concurrently from multiple threads once initialized.
+	 */
+	bool correlate(const signalVector &x, signalVector &y,
+		       size_t start, size_t len);
+
+	/* Get number of output samples produced by each transform */
+	size_t len();
+
+private:
+	size_t hLen;
+	size_t fftLen;
+	size_t blockLen;
+
+	/* Time domain taps and frequency domain taps with 1/fftLen scaling */
+	signalVector seq;
+	float *taps;
+
+	/* Pointers to opaque FFT instances */
+	struct fft_hdl *fwd, *inv;
+};
+
+#endif /* _FFT_CORRELATOR_H_ */
@@ -0,0 +1,225 @@
+/*
+ * Convolution kernel autotuning
+ *
+ * SPDX-License-Identifier: LGPL-2.1+
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "Logger.h"
+#include "KernelTuner.h"
+
+/*
+ * The cache starts with a header naming the kernel set version and the CPU,
+ * followed by one "<kind> <taps> <len> <kernel>" line per shape. A cache
+ * written for another kernel set or CPU, e.g. after an upgrade or after
+ * moving the state directory to another host, is discarded as a whole.
+ * Entries naming a kernel that is not usable are timed again and replaced.
+ */
+typedef std::tuple<int, size_t, size_t> TuneKey;
+typedef std::pair<int, size_t> ShapeKey;
+
+static bool tunerEnabled = false;
+static bool tunerDirty = false;
+static std::string tunerPath;
+static std::map<TuneKey, std::string> tunerCache;
+static std::set<ShapeKey> tunerShapes;
+
+/*
+ * Identify the CPU by the model and feature flags of the first processor,
+ * "model name" and "flags" on x86, implementer, part and "Features" on ARM
+ */
+static std::string cpuId()
+{
+	std::ifstream in("/proc/cpuinfo");
+	std::string line, model, flags;
+
+	while (std::getline(in, line) && !line.empty()) {
+		size_t pos = line.find(':');
+		if (pos == std::string::npos)
+			continue;
+
+		std::string key = line.substr(0, pos);
+		std::string val = line.substr(pos + 1);
+		key.erase(key.find_last_not_of(" \t") + 1);
+		val.erase(0, val.find_first_not_of(' '));
+
+		if ((key == "model name") || (key == "CPU implementer") ||
+		    (key == "CPU part"))
+			model += (model.empty() ? "" : " ") + val;
+		else if ((key == "flags") || (key == "Features"))
+			flags = val;
+	}
+
+	if (model.empty())
+		model = "unknown";
+
+	return model + "; " + flags;
+}
+
+static std::string cacheHeader()
+{
+	std::ostringstream ss;
+
+	ss << "kernels " << CONV_TUNE_VERSION << " cpu " << cpuId();
+	return ss.str();
+}
+
+static bool parseKind(const std::string &str, enum conv_kind *kind)
+{
+	static const enum conv_kind kinds[] = {
+		CONV_REAL, CONV_COMPLEX, CONV_POLYPHASE, CONV_PLANAR,
+	};
+
+	for (size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+		if (str == conv_kind_name(kinds[i])) {
+			*kind = kinds[i];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void loadCache()
+{
+	std::ifstream in(tunerPath.c_str());
+	std::string line, kindStr, name;
+	enum conv_kind kind;
+	size_t hLen, len;
+	bool header = false;
+
+	if (!in.is_open()) {
+		LOG(INFO) << "No kernel selection cache at " << tunerPath;
+		return;
+	}
+
+	while (std::getline(in, line)) {
+		if (line.empty() || (line[0] == '#'))
+			continue;
+
+		if (!header) {
+			if (line != cacheHeader()) {
+				LOG(NOTICE) << "Discarding kernel cache " << tunerPath
+					    << " written for another kernel set or CPU";
+				tunerDirty = true;
+				return;
+			}
+			header = true;
+			continue;
+		}
+
+		std::istringstream ss(line);
+		if (!(ss >> kindStr >> hLen >> len >> name) || !parseKind(kindStr, &kind)) {
+			LOG(NOTICE) << "Ignoring kernel cache entry '" << line << "'";
+			continue;
+		}
+
+		tunerCache[TuneKey(kind, hLen, len)] = name;
+	}
+}
+
+/* Rewrite the whole cache, it only holds a handful of lines */
+static void saveCache()
+{
+	std::string tmp = tunerPath + ".tmp";
+	std::string dir = tunerPath.substr(0, tunerPath.rfind('/'));
+
+	if (!dir.empty() && (dir != tunerPath) &&
+	    (mkdir(dir.c_str(), 0755) < 0) && (errno != EEXIST)) {
+		LOG(NOTICE) << "Cannot create kernel cache directory " << dir;
+		return;
+	}
+
+	std::ofstream out(tmp.c_str());
+	if (!out.is_open()) {
+		LOG(NOTICE) << "Cannot write kernel cache " << tmp;
+		return;
+	}
+
+	out << "# osmo-trx convolution kernel selection" << std::endl;
+	out << cacheHeader() << std::endl;
+	for (auto &e : tunerCache) {
+		out << conv_kind_name((enum conv_kind) std::get<0>(e.first)) << " "
+		    << std::get<1>(e.first) << " " << std::get<2>(e.first) << " "
+		    << e.second << std::endl;
+	}
+	out.close();
+
+	if (out.fail() || (rename(tmp.c_str(), tunerPath.c_str()) < 0))
+		LOG(NOTICE) << "Cannot write kernel cache " << tunerPath;
+}
+
+void kernelTunerInit(const std::string &path)
+{
+	tunerEnabled = true;
+	tunerDirty = false;
+	tunerPath = path;
+	tunerCache.clear();
+	tunerShapes.clear();
+
+	if (!tunerPath.empty())
+		loadCache();
+}
+
+void kernelTunerShape(enum conv_kind kind, size_t h_len, size_t len)
+{
+	TuneKey key(kind, h_len, len);
+
+	if (!tunerEnabled || !tunerShapes.insert(ShapeKey(kind, h_len)).second)
+		return;
+
+	auto cached = tunerCache.find(key);
+	if (cached != tunerCache.end()) {
+		if (!convolve_select(kind, h_len, cached->second.c_str())) {
+			LOG(INFO) << "Kernel for " << conv_kind_name(kind) << " taps "
+			          << h_len << ": " << cached->second << " (cached)";
+			return;
+		}
+		tunerCache.erase(cached);
+		tunerDirty = true;
+	}
+
+	const char *name = convolve_tune(kind, h_len, len);
+	if (!name) {
+		LOG(NOTICE) << "No kernel tuned for " << conv_kind_name(kind)
+		            << " taps " << h_len;
+		return;
+	}
+
+	LOG(INFO) << "Kernel for " << conv_kind_name(kind) << " taps "
+	          << h_len << ": " << name;
+
+	tunerCache[key] = name;
+	tunerDirty = true;
+}
+
+void kernelTunerSave()
+{
+	if (!tunerEnabled || tunerPath.empty() || !tunerDirty)
+		return;
+
+	saveCache();
+	tunerDirty = false;
+}
@@ -0,0 +1,59 @@
+/*
+ * Convolution kernel autotuning
+ *
+ * SPDX-License-Identifier: LGPL-2.1+
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _KERNEL_TUNER_H_
+#define _KERNEL_TUNER_H_
+
+#include <string>
+
+extern "C" {
+#include "convolve.h"
+}
+
+/* Enable kernel autotuning
+ *   @param path selection cache file, empty to tune without a cache
+ *
+ * Must be called before the filters are set up, i.e. before the radio
+ * interface and the transceiver are initialized. Selections found in the
+ * cache are applied as the shapes are registered instead of timing them.
+ */
+void kernelTunerInit(const std::string &path);
+
+/* Register a filter shape
+ *   @param kind convolution type
+ *   @param h_len number of filter taps
+ *   @param len typical number of output samples per call
+ *
+ * Does nothing unless tuning is enabled. The first registration of a kind
+ * and tap count selects the kernel for all calls with that tap count, a
+ * cached selection is only reused for the same output length.
+ * Not thread-safe, call during setup only.
+ */
+void kernelTunerShape(enum conv_kind kind, size_t h_len, size_t len);
+
+/* Write the selection cache
+ *
+ * Call once after the last filter shape is registered. Does nothing unless
+ * tuning is enabled with a cache and a selection has changed since the
+ * cache was read.
+ */
+void kernelTunerSave();
+
+#endif /* _KERNEL_TUNER_H_ */
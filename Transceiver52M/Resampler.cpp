@@ -27,6 +27,7 @@
 #include <algorithm>
 
 #include "Resampler.h"
+#include "KernelTuner.h"
 
 extern "C" {
 #include "convolve.h"
@@ -38,6 +39,9 @@ extern "C" {
 
 #define MAX_OUTPUT_LEN		4096
 
+/* Typical output block for kernel autotuning */
+#define TUNE_OUTPUT_LEN		512
+
 using namespace std;
 
 static float sinc(float x)
@@ -57,10 +61,12 @@ void Resampler::initFilters(float bw)
 	 * Allocate partition filters and the temporary prototype filter
 	 * according to numerator of the rational rate. Coefficients are
 	 * real only and must be 16-byte memory aligned for SSE usage.
+	 * Partitions are stored back to back in a single block so the
+	 * polyphase kernel can address path n at offset n * filt_len.
 	 */
 	auto proto = vector<float>(p * filt_len);
-	for (auto &part : partitions)
-		part = (complex<float> *) memalign(16, filt_len * sizeof(complex<float>));
+	partitions = (complex<float> *)
+		memalign(16, p * filt_len * sizeof(complex<float>));
 
 	/*
 	 * Generate the prototype filter with a Blackman-harris window.
@@ -91,12 +97,13 @@ void Resampler::initFilters(float bw)
 	/* Populate filter partitions from the prototype filter */
 	for (size_t i = 0; i < filt_len; i++) {
 		for (size_t n = 0; n < p; n++)
-			partitions[n][i] = complex<float>(proto[i * p + n] * scale);
+			partitions[n * filt_len + i] =
+				complex<float>(proto[i * p + n] * scale);
 	}
 
 	/* Store filter taps in reverse */
-	for (auto &part : partitions)
-		reverse(&part[0], &part[filt_len]);
+	for (size_t n = 0; n < p; n++)
+		reverse(&partitions[n * filt_len], &partitions[(n + 1) * filt_len]);
 }
 
 static bool check_vec_len(int in_len, int out_len, int p, int q)
@@ -132,23 +139,14 @@ static bool check_vec_len(int in_len, int out_len, int p, int q)
 
 int Resampler::rotate(const float *in, size_t in_len, float *out, size_t out_len)
 {
-	int n, path;
-
 	if (!check_vec_len(in_len, out_len, p, q))
 		return -1;
 
 	/* Generate output from precomputed input/output paths */
-	for (size_t i = 0; i < out_len; i++) {
-		n = in_index[i];
-		path = out_path[i];
-
-		convolve_real(in, in_len,
-			      reinterpret_cast<float *>(partitions[path]),
-			      filt_len, &out[2 * i], out_len - i,
-			      n, 1);
-	}
-
-	return out_len;
+	return convolve_real_polyphase(in, in_len,
+				       reinterpret_cast<float *>(partitions),
+				       filt_len, out, out_len,
+				       &in_index[0], &out_path[0], out_len);
 }
 
 bool Resampler::init(float bw)
@@ -166,6 +164,8 @@ bool Resampler::init(float bw)
 	for (auto &path : out_path)
 		path = (q * i++) % p;
 
+	kernelTunerShape(CONV_POLYPHASE, filt_len, TUNE_OUTPUT_LEN);
+
 	return true;
 }
 
@@ -174,8 +174,16 @@ size_t Resampler::len()
 	return filt_len;
 }
 
+const complex<float> *Resampler::taps(size_t n)
+{
+	if (!partitions || n >= p)
+		return NULL;
+
+	return &partitions[n * filt_len];
+}
+
 Resampler::Resampler(size_t p, size_t q, size_t filt_len)
-	: in_index(MAX_OUTPUT_LEN), out_path(MAX_OUTPUT_LEN), partitions(p)
+	: in_index(MAX_OUTPUT_LEN), out_path(MAX_OUTPUT_LEN), partitions(NULL)
 {
 	this->p = p;
 	this->q = q;
@@ -184,6 +192,5 @@ Resampler::Resampler(size_t p, size_t q, size_t filt_len)
 
 Resampler::~Resampler()
 {
-	for (auto &part : partitions)
-		free(part);
+	free(partitions);
 }
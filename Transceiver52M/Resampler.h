@@ -64,13 +64,19 @@ public:
 	 */
 	size_t len();
 
+	/* Get polyphase subfilter taps
+	 *   @param n filter partition index
+	 *   @return filt_len real valued taps stored in reverse, NULL on error
+	 */
+	const std::complex<float> *taps(size_t n);
+
 private:
 	size_t p;
 	size_t q;
 	size_t filt_len;
-	std::vector<size_t> in_index;
-	std::vector<size_t> out_path;
-	std::vector<std::complex<float> *> partitions;
+	std::vector<int> in_index;
+	std::vector<int> out_path;
+	std::complex<float> *partitions;
 
 	void initFilters(float bw);
 };
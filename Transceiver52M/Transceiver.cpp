@@ -24,6 +24,7 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <netinet/in.h>
 #include <iomanip>      // std::setprecision
 #include <fstream>
@@ -33,6 +34,7 @@
 extern "C" {
 #include "osmo_signal.h"
 #include "proto_trxd.h"
+#include "trx_rate_ctr.h"
 
 #include <osmocom/core/utils.h>
 #include <osmocom/core/socket.h>
@@ -52,8 +54,13 @@ Transceiver *transceiver;
 /* Number of running values use in noise average */
 #define NOISE_CNT			20
 
+/* Symbols searched on either side of the tracked timing, and its lifetime */
+#define TOA_TRACK_MARGIN		2
+#define TOA_TRACK_FN			104
+
 TransceiverState::TransceiverState()
-  : mRetrans(false), mNoiseLev(0.0), mNoises(NOISE_CNT), mPower(0.0)
+  : mRetrans(false), mNoiseLev(0.0), mNoises(NOISE_CNT), mPower(0.0),
+    mPendingBurst(NULL)
 {
   for (int i = 0; i < 8; i++) {
     chanType[i] = Transceiver::NONE;
@@ -64,7 +71,11 @@ TransceiverState::TransceiverState()
 
     for (int n = 0; n < 102; n++)
       fillerTable[n][i] = NULL;
+
+    for (int n = 0; n < 8; n++)
+      chanRespFN[i][n] = -1;
   }
+  chanRespReset = 0;
   memset(&ctrs, 0, sizeof(struct trx_counters));
 }
 
@@ -78,6 +89,8 @@ TransceiverState::~TransceiverState()
     for (int n = 0; n < 102; n++)
       delete fillerTable[n][i];
   }
+
+  delete mPendingBurst;
 }
 
 bool TransceiverState::init(FillerType filler, size_t sps, float scale, size_t rtsc, unsigned rach_delay)
@@ -133,7 +146,8 @@ Transceiver::Transceiver(int wBasePort,
     mSPSTx(tx_sps), mSPSRx(rx_sps), mChans(chans), mExtRACH(false), mEdge(false),
     mOn(false), mForceClockInterface(false),
     mTxFreq(0.0), mRxFreq(0.0), mTSC(0), mMaxExpectedDelayAB(0), mMaxExpectedDelayNB(0),
-    mWriteBurstToDiskMask(0)
+    mWriteBurstToDiskMask(0), mRxGate(0.0f), mToaTrack(false),
+    mRxFrameBatch(false)
 {
   txFullScale = mRadioInterface->fullScaleInputValue();
   rxFullScale = mRadioInterface->fullScaleOutputValue();
@@ -188,7 +202,8 @@ int Transceiver::ctrl_sock_cb(struct osmo_fd *bfd, unsigned int flags)
  * activity.
  */
 bool Transceiver::init(FillerType filler, size_t rtsc, unsigned rach_delay,
-                       bool edge, bool ext_rach)
+                       bool edge, bool ext_rach, unsigned rx_snr_gate,
+                       bool rx_toa_track, bool rx_frame_batch)
 {
   int d_srcport, d_dstport, c_srcport, c_dstport;
 
@@ -204,6 +219,9 @@ bool Transceiver::init(FillerType filler, size_t rtsc, unsigned rach_delay,
 
   mExtRACH = ext_rach;
   mEdge = edge;
+  mRxGate = rx_snr_gate ? powf(10.0f, rx_snr_gate / 10.0f) : 0.0f;
+  mToaTrack = rx_toa_track;
+  mRxFrameBatch = rx_frame_batch;
 
   mDataSockets.resize(mChans, -1);
   mCtrlSockets.resize(mChans);
@@ -365,6 +383,9 @@ void Transceiver::stop()
     delete mTxPriorityQueueServiceLoopThreads[i];
 
     mTxPriorityQueues[i].clear();
+
+    delete mStates[i].mPendingBurst;
+    mStates[i].mPendingBurst = NULL;
   }
 
   mOn = false;
@@ -376,6 +397,7 @@ void Transceiver::addRadioVector(size_t chan, BitVector &bits,
 {
   signalVector *burst;
   radioVector *radio_burst;
+  bool ok;
 
   if (chan >= mTxPriorityQueues.size()) {
     LOGCHAN(chan, DTRXDDL, FATAL) << "Invalid channel";
@@ -387,11 +409,21 @@ void Transceiver::addRadioVector(size_t chan, BitVector &bits,
     return;
   }
 
+  /* The burst is owned by the Tx queue, the stages leading to it are not */
+  burst = new signalVector();
+
   /* Use the number of bits as the EDGE burst indicator */
   if (bits.size() == EDGE_BURST_NBITS)
-    burst = modulateEdgeBurst(bits, mSPSTx);
+    ok = modulateEdgeBurst(bits, mSPSTx, *burst, mStates[chan].txWorkspace);
   else
-    burst = modulateBurst(bits, 8 + (wTime.TN() % 4 == 0), mSPSTx);
+    ok = modulateBurst(bits, 8 + (wTime.TN() % 4 == 0), mSPSTx, *burst,
+                       mStates[chan].txWorkspace);
+
+  if (!ok) {
+    LOGCHAN(chan, DTRXDDL, ERROR) << "Failed to modulate burst";
+    delete burst;
+    return;
+  }
 
   scaleVector(*burst, txFullScale * pow(10, -RSSI / 10));
 
@@ -501,15 +533,38 @@ void Transceiver::setModulus(size_t timeslot, size_t chan)
   }
 }
 
+/* Subslot of each frame on the shared dedicated channel combinations */
+static const int tchh_subslot[26] = { 0,1,0,1,0,1,0,1,0,1,0,1,0,0,1,0,1,0,1,0,1,0,1,0,1,1 };
+static const int sdcch4_subslot[102] = { 3,3,3,3,0,0,2,2,2,2,3,3,3,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,2,2,2,2,
+                                         3,3,3,3,0,0,0,0,0,0,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,2,2,2,2 };
+static const int sdcch8_subslot[102] = { 5,5,5,5,6,6,6,6,7,7,7,7,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7,0,0,0,0,
+                                         1,1,1,1,2,2,2,2,3,3,3,3,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7,4,4,4,4 };
+
+/*
+ * Subslot of a normal burst on a dedicated channel, whose timing is tracked
+ * between bursts. Returns -1 for combinations that are shared by several
+ * mobiles, e.g. PDCH, or that carry no normal bursts from a single mobile.
+ */
+static int trackedSubslot(int chanType, unsigned burstFN)
+{
+  switch (chanType) {
+  case Transceiver::I:
+    return 0;
+  case Transceiver::II:
+  case Transceiver::III:
+    return tchh_subslot[burstFN % 26];
+  case Transceiver::V:
+    return sdcch4_subslot[burstFN % 102];
+  case Transceiver::VII:
+    return sdcch8_subslot[burstFN % 102];
+  default:
+    return -1;
+  }
+}
 
 CorrType Transceiver::expectedCorrType(GSM::Time currTime,
                                        size_t chan)
 {
-  static int tchh_subslot[26] = { 0,1,0,1,0,1,0,1,0,1,0,1,0,0,1,0,1,0,1,0,1,0,1,0,1,1 };
-  static int sdcch4_subslot[102] = { 3,3,3,3,0,0,2,2,2,2,3,3,3,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,2,2,2,2,
-                                     3,3,3,3,0,0,0,0,0,0,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,2,2,2,2 };
-  static int sdcch8_subslot[102] = { 5,5,5,5,6,6,6,6,7,7,7,7,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7,0,0,0,0,
-                                     1,1,1,1,2,2,2,2,3,3,3,3,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7,4,4,4,4 };
   TransceiverState *state = &mStates[chan];
   unsigned burstTN = currTime.TN();
   unsigned burstFN = currTime.FN();
@@ -603,34 +658,26 @@ void writeToFile(radioVector *radio_burst, size_t chan)
 }
 
 /*
- * Pull bursts from the FIFO and handle according to the slot
- * and burst correlation type. Equalzation is currently disabled.
- * returns 0 on success (bi filled), negative on error (bi content undefined):
- *        -ENOENT: timeslot is off (fn and tn in bi are filled),
- *        -EIO: read error
+ * Fill in the burst indication of a received burst, measure the burst and
+ * noise energy, and determine the correlation type. Returns -ENOENT if the
+ * timeslot is off, zero if the burst is idle and positive if it is to be
+ * detected.
  */
-int Transceiver::pullRadioVector(size_t chan, struct trx_ul_burst_ind *bi)
+int Transceiver::measureRadioVector(size_t chan, struct rx_burst *rx,
+                                    struct trx_ul_burst_ind *bi)
 {
-  int rc;
-  struct estim_burst_params ebp;
-  float max = -1.0, avg = 0.0;
-  unsigned max_toa;
+  float max = -1.0, avg = 0.0, ampl;
   int max_i = -1;
-  signalVector *burst;
   GSM::Time burstTime;
-  SoftVector *rxBurst;
   TransceiverState *state = &mStates[chan];
-
-  /* Blocking FIFO read */
-  radioVector *radio_burst = mReceiveFIFO[chan]->read();
-  if (!radio_burst) {
-    LOGCHAN(chan, DTRXDUL, ERROR) << "ReceiveFIFO->read() returned no burst";
-    return -EIO;
-  }
+  radioVector *radio_burst = rx->radio_burst;
 
   /* Set time and determine correlation type */
   burstTime = radio_burst->getTime();
-  CorrType type = expectedCorrType(burstTime, chan);
+  rx->type = expectedCorrType(burstTime, chan);
+  rx->max_ampl = -1.0;
+  rx->subslot = -1;
+  rx->rc = 0;
 
   /* Initialize struct bi */
   bi->nbits = 0;
@@ -653,17 +700,16 @@ int Transceiver::pullRadioVector(size_t chan, struct trx_ul_burst_ind *bi)
 
   /* No processing if the timeslot is off.
    * Not even power level or noise calculation. */
-  if (type == OFF) {
-    delete radio_burst;
+  if (rx->type == OFF)
     return -ENOENT;
-  }
 
   /* Select the diversity channel with highest energy */
   for (size_t i = 0; i < radio_burst->chans(); i++) {
-    float pow = energyDetect(*radio_burst->getVector(i), 20 * mSPSRx);
+    float pow = energyDetect(*radio_burst->getVector(i), 20 * mSPSRx, &ampl);
     if (pow > max) {
       max = pow;
       max_i = i;
+      rx->max_ampl = ampl;
     }
     avg += pow;
   }
@@ -674,10 +720,10 @@ int Transceiver::pullRadioVector(size_t chan, struct trx_ul_burst_ind *bi)
   }
 
   /* Average noise on diversity paths and update global levels */
-  burst = radio_burst->getVector(max_i);
+  rx->burst = radio_burst->getVector(max_i);
   avg = sqrt(avg / radio_burst->chans());
 
-  if (type == IDLE) {
+  if (rx->type == IDLE) {
     /* Update noise levels */
     state->mNoises.insert(avg);
     state->mNoiseLev = state->mNoises.avg();
@@ -686,47 +732,231 @@ int Transceiver::pullRadioVector(size_t chan, struct trx_ul_burst_ind *bi)
   bi->rssi = 20.0 * log10(rxFullScale / avg) + rssiOffset;
   bi->noise = 20.0 * log10(rxFullScale / state->mNoiseLev) + rssiOffset;
 
-  if (type == IDLE)
+  if (rx->type == IDLE)
+    goto ret_idle;
+
+  /*
+   * Skip downsampling, correlation and peak search if the strongest path
+   * is not above the noise level by the SNR gate. The noise level is zero
+   * until the first idle slots were measured, which keeps the gate open.
+   */
+  if (max < mRxGate * state->mNoiseLev * state->mNoiseLev) {
+    trx_rate_ctr_rx_gated(chan);
     goto ret_idle;
+  }
 
-  max_toa = (type == RACH || type == EXT_RACH) ?
+  return 1;
+
+ret_idle:
+  bi->idle = true;
+  return 0;
+}
+
+/*
+ * On dedicated channels, first search around the timing of the previous
+ * burst of the same mobile, and the full window only on a miss
+ */
+void Transceiver::detectTrackedBurst(size_t chan, struct rx_burst *rx,
+                                     const struct trx_ul_burst_ind *bi)
+{
+  TransceiverState *state = &mStates[chan];
+  int subslot;
+
+  /* Apply the reset requested by SETSLOT, only this thread uses estimates */
+  if (osmo_trx_sync_fetch_and_and(&state->chanRespReset, ~(1 << bi->tn)) &
+      (1 << bi->tn)) {
+    for (int i = 0; i < 8; i++)
+      state->chanRespFN[bi->tn][i] = -1;
+  }
+
+  if (!mToaTrack || (rx->type != TSC))
+    return;
+
+  subslot = rx->subslot = trackedSubslot(state->chanType[bi->tn], bi->fn);
+
+  if ((subslot >= 0) && (state->chanRespFN[bi->tn][subslot] >= 0) &&
+      (abs(FNDelta(bi->fn, state->chanRespFN[bi->tn][subslot])) < TOA_TRACK_FN))
+    rx->rc = detectNormalBurst(*rx->burst, mTSC, BURST_THRESH, mSPSRx,
+                               state->chanRespOffset[bi->tn][subslot],
+                               TOA_TRACK_MARGIN, mMaxExpectedDelayNB,
+                               &rx->ebp, rx->max_ampl,
+                               &state->burstCtx[bi->tn], state->rxWorkspace);
+}
+
+/* Detect normal or RACH bursts over the full search window */
+void Transceiver::detectRadioVector(size_t chan, struct rx_burst *rx,
+                                    const struct trx_ul_burst_ind *bi)
+{
+  TransceiverState *state = &mStates[chan];
+  unsigned max_toa;
+
+  max_toa = (rx->type == RACH || rx->type == EXT_RACH) ?
             mMaxExpectedDelayAB : mMaxExpectedDelayNB;
 
-  /* Detect normal or RACH bursts */
-  rc = detectAnyBurst(*burst, mTSC, BURST_THRESH, mSPSRx, type, max_toa, &ebp);
-  if (rc <= 0) {
-    if (rc == -SIGERR_CLIP)
+  rx->rc = detectAnyBurst(*rx->burst, mTSC, BURST_THRESH, mSPSRx, rx->type,
+                          max_toa, &rx->ebp, rx->max_ampl,
+                          &state->burstCtx[bi->tn], state->rxWorkspace);
+}
+
+/* Demodulate a detected burst, or mark it idle if detection failed */
+void Transceiver::demodRadioVector(size_t chan, struct rx_burst *rx,
+                                   struct trx_ul_burst_ind *bi)
+{
+  TransceiverState *state = &mStates[chan];
+  CorrType type;
+  int rc;
+
+  if (rx->rc <= 0) {
+    if (rx->rc == -SIGERR_CLIP)
       LOGCHAN(chan, DTRXDUL, NOTICE) << "Clipping detected on received RACH or Normal Burst";
-    else if (rc != SIGERR_NONE)
+    else if (rx->rc != SIGERR_NONE)
       LOGCHAN(chan, DTRXDUL, NOTICE) << "Unhandled RACH or Normal Burst detection error";
-    goto ret_idle;
+    bi->idle = true;
+    return;
+  }
+
+  if (rx->subslot >= 0) {
+    state->chanRespOffset[bi->tn][rx->subslot] = rx->ebp.toa;
+    state->chanRespFN[bi->tn][rx->subslot] = bi->fn;
   }
 
-  type = (CorrType) rc;
-  bi->toa = ebp.toa;
-  bi->tsc = ebp.tsc;
-  bi->ci = ebp.ci;
-  rxBurst = demodAnyBurst(*burst, mSPSRx, ebp.amp, ebp.toa, type);
+  type = (CorrType) rx->rc;
+  bi->toa = rx->ebp.toa;
+  bi->tsc = rx->ebp.tsc;
+  bi->ci = rx->ebp.ci;
 
   /* EDGE demodulator returns 444 (gSlotLen * 3) bits */
-  if (rxBurst->size() == EDGE_BURST_NBITS) {
+  if (type == EDGE) {
     bi->modulation = MODULATION_8PSK;
     bi->nbits = EDGE_BURST_NBITS;
-  } else { /* size() here is actually gSlotLen + 8, due to guard periods */
+  } else { /* GMSK returns gSlotLen + 8 bits, due to guard periods */
     bi->modulation = MODULATION_GMSK;
     bi->nbits = gSlotLen;
   }
 
-  // Convert -1..+1 soft bits to 0..1 soft bits
-  vectorSlicer(bi->rx_burst, rxBurst->begin(), bi->nbits);
+  /* Demodulate straight into the 0..255 TRXD soft bits */
+  rc = demodAnyBurst(*rx->burst, mSPSRx, rx->ebp.amp, rx->ebp.toa, type,
+                     bi->soft_bits, bi->nbits, &state->burstCtx[bi->tn],
+                     state->rxWorkspace);
+  if (rc < (int) bi->nbits) {
+    LOGCHAN(chan, DTRXDUL, NOTICE) << "Failed to demodulate burst";
+    bi->nbits = 0;
+    bi->idle = true;
+  }
+}
 
-  delete rxBurst;
-  delete radio_burst;
-  return 0;
+/*
+ * Pull bursts from the FIFO and handle according to the slot
+ * and burst correlation type. Equalzation is currently disabled.
+ * returns 0 on success (bi filled), negative on error (bi content undefined):
+ *        -ENOENT: timeslot is off (fn and tn in bi are filled),
+ *        -EIO: read error
+ */
+int Transceiver::pullRadioVector(size_t chan, struct trx_ul_burst_ind *bi)
+{
+  struct rx_burst rx;
+  int rc;
 
-ret_idle:
-  bi->idle = true;
-  delete radio_burst;
+  /* Blocking FIFO read */
+  rx.radio_burst = mReceiveFIFO[chan]->read();
+  if (!rx.radio_burst) {
+    LOGCHAN(chan, DTRXDUL, ERROR) << "ReceiveFIFO->read() returned no burst";
+    return -EIO;
+  }
+
+  rc = measureRadioVector(chan, &rx, bi);
+  if (rc > 0) {
+    detectTrackedBurst(chan, &rx, bi);
+    if (rx.rc <= 0)
+      detectRadioVector(chan, &rx, bi);
+    demodRadioVector(chan, &rx, bi);
+  }
+
+  delete rx.radio_burst;
+  return rc < 0 ? rc : 0;
+}
+
+/*
+ * Pull the bursts of a TDMA frame from the FIFO and handle them as
+ * pullRadioVector() does, one stage at a time for all bursts. Normal bursts
+ * that need a full window search are detected together. A burst of the next
+ * frame ends the frame early and is kept for the next call.
+ * returns 0 on success with the result of each burst in rc as returned by
+ * pullRadioVector(), -EIO on read error.
+ */
+int Transceiver::pullRadioFrame(size_t chan, struct trx_ul_burst_ind *bi,
+                                int *rc, size_t *num)
+{
+  TransceiverState *state = &mStates[chan];
+  struct rx_burst rx[8];
+  const signalVector *bursts[8];
+  struct burst_ctx *ctx[8];
+  struct estim_burst_params ebp[8];
+  float max_ampl[8];
+  int idx[8], res[8];
+  size_t n = 0, batch = 0;
+  radioVector *radio_burst;
+
+  /* Gather the bursts up to the last timeslot of the frame */
+  do {
+    radio_burst = state->mPendingBurst;
+    state->mPendingBurst = NULL;
+    if (!radio_burst)
+      radio_burst = mReceiveFIFO[chan]->read();
+    if (!radio_burst) {
+      LOGCHAN(chan, DTRXDUL, ERROR) << "ReceiveFIFO->read() returned no burst";
+      for (size_t i = 0; i < n; i++)
+        delete rx[i].radio_burst;
+      return -EIO;
+    }
+
+    if (n && (radio_burst->getTime().FN() != rx[0].radio_burst->getTime().FN())) {
+      state->mPendingBurst = radio_burst;
+      break;
+    }
+    rx[n++].radio_burst = radio_burst;
+  } while ((n < 8) && (radio_burst->getTime().TN() != 7));
+
+  for (size_t i = 0; i < n; i++) {
+    rc[i] = measureRadioVector(chan, &rx[i], &bi[i]);
+    if (rc[i] <= 0)
+      continue;
+
+    detectTrackedBurst(chan, &rx[i], &bi[i]);
+    if (rx[i].rc > 0)
+      continue;
+
+    if (rx[i].type != TSC) {
+      detectRadioVector(chan, &rx[i], &bi[i]);
+      continue;
+    }
+
+    idx[batch] = i;
+    bursts[batch] = rx[i].burst;
+    max_ampl[batch] = rx[i].max_ampl;
+    ctx[batch] = &state->burstCtx[bi[i].tn];
+    batch++;
+  }
+
+  if (batch) {
+    detectNormalBursts(bursts, batch, mTSC, BURST_THRESH, mSPSRx,
+                       mMaxExpectedDelayNB, ebp, max_ampl, ctx, res,
+                       state->rxWorkspace);
+    for (size_t i = 0; i < batch; i++) {
+      rx[idx[i]].rc = res[i];
+      rx[idx[i]].ebp = ebp[i];
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (rc[i] > 0) {
+      demodRadioVector(chan, &rx[i], &bi[i]);
+      rc[i] = 0;
+    }
+    delete rx[i].radio_burst;
+  }
+
+  *num = n;
   return 0;
 }
 
@@ -961,6 +1191,7 @@ int Transceiver::ctrl_sock_handle_rx(int chan)
       return 0;
     }
     mStates[chan].chanType[timeslot] = (ChannelCombination) corrCode;
+    osmo_trx_sync_or_and_fetch(&mStates[chan].chanRespReset, 1 << timeslot);
     setModulus(timeslot, chan);
     sprintf(response,"RSP SETSLOT 0 %d %d",timeslot,corrCode);
   } else if (match_cmd(command, "SETFORMAT", &params)) {
@@ -1080,9 +1311,9 @@ void Transceiver::logRxBurst(size_t chan, const struct trx_ul_burst_ind *bi)
 {
   std::ostringstream os;
   for (size_t i=0; i < bi->nbits; i++) {
-    if (bi->rx_burst[i] > 0.5) os << "1";
-    else if (bi->rx_burst[i] > 0.25) os << "|";
-    else if (bi->rx_burst[i] > 0.0) os << "'";
+    if (bi->soft_bits[i] > 127) os << "1";
+    else if (bi->soft_bits[i] > 63) os << "|";
+    else if (bi->soft_bits[i] > 0) os << "'";
     else os << "-";
   }
 
@@ -1099,28 +1330,46 @@ void Transceiver::logRxBurst(size_t chan, const struct trx_ul_burst_ind *bi)
 
 bool Transceiver::driveReceiveFIFO(size_t chan)
 {
-  struct trx_ul_burst_ind bi;
-  int rc;
+  struct trx_ul_burst_ind bi[8];
+  int rc[8];
+  size_t num = 1;
+  bool ok;
 
-  if ((rc = pullRadioVector(chan, &bi)) < 0) {
-    if (rc == -ENOENT) { /* timeslot off, continue processing */
-      LOGCHAN(chan, DTRXDUL, DEBUG) << unsigned(bi.tn) << ":" << bi.fn << " timeslot is off";
-      return true;
-    }
-    return false; /* other errors: we want to stop the process */
+  if (mRxFrameBatch) {
+    if (pullRadioFrame(chan, bi, rc, &num) < 0)
+      return false;
+  } else {
+    rc[0] = pullRadioVector(chan, &bi[0]);
   }
 
-  if (!bi.idle)
-    logRxBurst(chan, &bi);
+  for (size_t i = 0; i < num; i++) {
+    if (rc[i] < 0) {
+      if (rc[i] == -ENOENT) { /* timeslot off, continue processing */
+        LOGCHAN(chan, DTRXDUL, DEBUG) << unsigned(bi[i].tn) << ":" << bi[i].fn << " timeslot is off";
+        continue;
+      }
+      return false; /* other errors: we want to stop the process */
+    }
 
-  switch (mVersionTRXD[chan]) {
-    case 0:
-      return trxd_send_burst_ind_v0(chan, mDataSockets[chan], &bi);
-    case 1:
-      return trxd_send_burst_ind_v1(chan, mDataSockets[chan], &bi);
-    default:
-      OSMO_ASSERT(false);
+    if (!bi[i].idle)
+      logRxBurst(chan, &bi[i]);
+
+    switch (mVersionTRXD[chan]) {
+      case 0:
+        ok = trxd_send_burst_ind_v0(chan, mDataSockets[chan], &bi[i]);
+        break;
+      case 1:
+        ok = trxd_send_burst_ind_v1(chan, mDataSockets[chan], &bi[i]);
+        break;
+      default:
+        OSMO_ASSERT(false);
+    }
+
+    if (!ok)
+      return false;
   }
+
+  return true;
 }
 
 void Transceiver::driveTxFIFO()
@@ -74,9 +74,22 @@ struct TransceiverState {
 
   /* Most recent SNR, timing, and channel amplitude estimates */
   float SNRestimate[8];
-  float chanRespOffset[8];
+  float chanRespOffset[8][8];
   complex chanRespAmplitude[8];
 
+  /* Frame number of the timing estimate per timeslot and subslot, -1 if none */
+  int chanRespFN[8][8];
+
+  /* Timeslots whose timing estimates are to be reset by the Rx thread */
+  int chanRespReset;
+
+  /* Products of the last burst detection reused by the demodulator */
+  struct burst_ctx burstCtx[8];
+
+  /* Scratch buffers of the receive and transmit paths */
+  SigProcWorkspace rxWorkspace;
+  SigProcWorkspace txWorkspace;
+
   /* Received noise energy levels */
   float mNoiseLev;
   noiseVector mNoises;
@@ -86,6 +99,20 @@ struct TransceiverState {
 
   /* counters */
   struct trx_counters ctrs;
+
+  /* First burst of the next frame when gathering frames for detection */
+  radioVector *mPendingBurst;
+};
+
+/** Received burst between the stages of the receive path */
+struct rx_burst {
+  radioVector *radio_burst;
+  signalVector *burst;
+  CorrType type;
+  float max_ampl;
+  int subslot;
+  int rc;
+  struct estim_burst_params ebp;
 };
 
 /** The Transceiver class, responsible for physical layer of basestation */
@@ -112,7 +139,8 @@ public:
 
   /** Start the control loop */
   bool init(FillerType filler, size_t rtsc, unsigned rach_delay,
-            bool edge, bool ext_rach);
+            bool edge, bool ext_rach, unsigned rx_snr_gate,
+            bool rx_toa_track, bool rx_frame_batch);
 
   /** attach the radioInterface receive FIFO */
   bool receiveFIFO(VectorFIFO *wFIFO, size_t chan)
@@ -210,6 +238,15 @@ struct ctrl_sock_state {
   /** Pull and demodulate a burst from the receive FIFO */
   int pullRadioVector(size_t chan, struct trx_ul_burst_ind *ind);
 
+  /** Pull and demodulate the bursts of a TDMA frame from the receive FIFO */
+  int pullRadioFrame(size_t chan, struct trx_ul_burst_ind *ind, int *rc, size_t *num);
+
+  /** Receive path stages of pullRadioVector() and pullRadioFrame() */
+  int measureRadioVector(size_t chan, struct rx_burst *rx, struct trx_ul_burst_ind *ind);
+  void detectTrackedBurst(size_t chan, struct rx_burst *rx, const struct trx_ul_burst_ind *ind);
+  void detectRadioVector(size_t chan, struct rx_burst *rx, const struct trx_ul_burst_ind *ind);
+  void demodRadioVector(size_t chan, struct rx_burst *rx, struct trx_ul_burst_ind *ind);
+
   /** Set modulus for specific timeslot */
   void setModulus(size_t timeslot, size_t chan);
 
@@ -240,6 +277,9 @@ struct ctrl_sock_state {
   unsigned mMaxExpectedDelayAB;        ///< maximum expected time-of-arrival offset in GSM symbols for Access Bursts (RACH)
   unsigned mMaxExpectedDelayNB;        ///< maximum expected time-of-arrival offset in GSM symbols for Normal Bursts
   unsigned mWriteBurstToDiskMask;      ///< debug: bitmask to indicate which timeslots to dump to disk
+  float mRxGate;                       ///< minimum burst to noise power ratio for detection, zero to detect always
+  bool mToaTrack;                      ///< search dedicated channels around the timing of the previous burst
+  bool mRxFrameBatch;                  ///< gather the bursts of a TDMA frame and detect them together
 
   std::vector<unsigned> mVersionTRXD;  ///< Format version to use for TRXD protocol communication, per channel
   std::vector<TransceiverState> mStates;
@@ -85,3 +85,29 @@ void convert_short_float(float *out, const short *in, int len)
 	base_convert_short_float(out, in, len);
 #endif
 }
+
+void convert_float_soft(unsigned char *out, const float *in, int len)
+{
+	base_convert_float_soft(out, in, len);
+}
+
+void convert_float_planar(float *re, float *im, const float *in, int len)
+{
+	base_convert_float_planar(re, im, in, len);
+}
+
+void convert_planar_float(float *out, const float *re, const float *im,
+			  int len)
+{
+	base_convert_planar_float(out, re, im, len);
+}
+
+void convert_float_half(unsigned short *out, const float *in, int len)
+{
+	base_convert_float_half(out, in, len);
+}
+
+void convert_half_float(float *out, const unsigned short *in, int len)
+{
+	base_convert_half_float(out, in, len);
+}
@@ -23,35 +23,60 @@
 #include <string.h>
 #include <stdio.h>
 
+#include "convolve.h"
+
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
 
 /* Forward declarations from base implementation */
-int _base_convolve_real(float *x, int x_len,
-			float *h, int h_len,
+int _base_convolve_real(const float *x, int x_len,
+			const float *h, int h_len,
 			float *y, int y_len,
 			int start, int len);
 
-int _base_convolve_complex(float *x, int x_len,
-			   float *h, int h_len,
+int _base_convolve_complex(const float *x, int x_len,
+			   const float *h, int h_len,
 			   float *y, int y_len,
 			   int start, int len);
 
+int _base_convolve_real_polyphase(const float *x, int x_len,
+				  const float *h, int h_len,
+				  float *y, int y_len,
+				  const int *index, const int *path, int len);
+
+int _base_convolve_complex_planar(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len);
+
+int _base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+					int x_len,
+					const float *h_re, const float *h_im,
+					int h_len, int h_num,
+					float *y_re, float *y_im, int y_len,
+					int start, int len);
+
 int bounds_check(int x_len, int h_len, int y_len,
 		 int start, int len);
 
+int polyphase_bounds_check(int x_len, int h_len, int y_len,
+			   const int *index, int len);
+
 #ifdef HAVE_NEON
 /* Calls into NEON assembler */
-void neon_conv_real4(float *x, float *h, float *y, int len);
-void neon_conv_real8(float *x, float *h, float *y, int len);
-void neon_conv_real12(float *x, float *h, float *y, int len);
-void neon_conv_real16(float *x, float *h, float *y, int len);
-void neon_conv_real20(float *x, float *h, float *y, int len);
-void mac_cx_neon4(float *x, float *h, float *y, int len);
+void neon_conv_real4(const float *x, const float *h, float *y, int len);
+void neon_conv_real8(const float *x, const float *h, float *y, int len);
+void neon_conv_real12(const float *x, const float *h, float *y, int len);
+void neon_conv_real16(const float *x, const float *h, float *y, int len);
+void neon_conv_real20(const float *x, const float *h, float *y, int len);
+void mac_cx_neon4(const float *x, const float *h, float *y, int len);
 
 /* Complex-complex convolution */
-static void neon_conv_cmplx_4n(float *x, float *h, float *y, int h_len, int len)
+static void neon_conv_cmplx_4n(const float *x, const float *h, float *y,
+			       int h_len, int len)
 {
 	for (int i = 0; i < len; i++)
 		mac_cx_neon4(&x[2 * i], h, &y[2 * i], h_len >> 2);
@@ -66,12 +91,12 @@ void convolve_init(void)
 }
 
 /* API: Aligned complex-real */
-int convolve_real(float *x, int x_len,
-		  float *h, int h_len,
+int convolve_real(const float *x, int x_len,
+		  const float *h, int h_len,
 		  float *y, int y_len,
 		  int start, int len)
 {
-	void (*conv_func)(float *, float *, float *, int) = NULL;
+	void (*conv_func)(const float *, const float *, float *, int) = NULL;
 
 	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
 		return -1;
@@ -112,12 +137,13 @@ int convolve_real(float *x, int x_len,
 
 
 /* API: Aligned complex-complex */
-int convolve_complex(float *x, int x_len,
-		     float *h, int h_len,
+int convolve_complex(const float *x, int x_len,
+		     const float *h, int h_len,
 		     float *y, int y_len,
 		     int start, int len)
 {
-	void (*conv_func)(float *, float *, float *, int, int) = NULL;
+	void (*conv_func)(const float *, const float *,
+			  float *, int, int) = NULL;
 
 	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
 		return -1;
@@ -140,3 +166,96 @@ int convolve_complex(float *x, int x_len,
 
 	return len;
 }
+
+/* API: Polyphase complex-real */
+int convolve_real_polyphase(const float *x, int x_len,
+			    const float *h, int h_len,
+			    float *y, int y_len,
+			    const int *index, const int *path, int len)
+{
+	void (*conv_func)(const float *, const float *, float *, int) = NULL;
+
+	if (polyphase_bounds_check(x_len, h_len, y_len, index, len) < 0)
+		return -1;
+
+#ifdef HAVE_NEON
+	switch (h_len) {
+	case 4:
+		conv_func = neon_conv_real4;
+		break;
+	case 8:
+		conv_func = neon_conv_real8;
+		break;
+	case 12:
+		conv_func = neon_conv_real12;
+		break;
+	case 16:
+		conv_func = neon_conv_real16;
+		break;
+	case 20:
+		conv_func = neon_conv_real20;
+		break;
+	}
+#endif
+	if (!conv_func) {
+		return _base_convolve_real_polyphase(x, x_len,
+						     h, h_len,
+						     y, y_len,
+						     index, path, len);
+	}
+
+	/* Single output per partition, the kernels store without accumulate */
+	for (int i = 0; i < len; i++) {
+		conv_func(&x[2 * (index[i] - (h_len - 1))],
+			  &h[2 * h_len * path[i]], &y[2 * i], 1);
+	}
+
+	return len;
+}
+
+/* API: Kernel autotuning, the NEON kernels are selected by tap count only */
+const char *convolve_tune(enum conv_kind kind, int h_len, int len)
+{
+	/* Stub */
+	return NULL;
+}
+
+/* API: Select a kernel by name for a filter shape */
+int convolve_select(enum conv_kind kind, int h_len, const char *name)
+{
+	/* Stub */
+	return -1;
+}
+
+/* API: Planar complex-complex */
+int convolve_complex_planar(const float *x_re, const float *x_im, int x_len,
+			    const float *h_re, const float *h_im, int h_len,
+			    float *y_re, float *y_im, int y_len,
+			    int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	_base_convolve_complex_planar(x_re, x_im, x_len, h_re, h_im, h_len,
+				      y_re, y_im, y_len, start, len);
+
+	return len;
+}
+
+/* API: Planar complex-complex against h_num sequences of equal length */
+int convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len, int h_num,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	_base_convolve_complex_planar_multi(x_re, x_im, x_len,
+					    h_re, h_im, h_len, h_num,
+					    y_re, y_im, y_len, start, len);
+
+	return len;
+}
@@ -29,30 +29,21 @@
 
 void neon_cmplx_mul_4n(float *, float *, float *, int);
 
-static void cmplx_mul_ps(float *out, float *a, float *b, int len)
+/* API: Initialize mult module */
+void mult_init(void)
 {
-	float ai, aq, bi, bq;
-
-	for (int i = 0; i < len; i++) {
-		ai = a[2 * i + 0];
-		aq = a[2 * i + 1];
-
-		bi = b[2 * i + 0];
-		bq = b[2 * i + 1];
-
-		out[2 * i + 0] = ai * bi - aq * bq;
-		out[2 * i + 1] = ai * bq + aq * bi;
-	}
+	/* Stub */
+	return;
 }
 
 void mul_complex(float *out, float *a, float *b, int len)
 {
 #ifdef HAVE_NEON
 	if (len % 4)
-		cmplx_mul_ps(out, a, b, len);
+		base_mul_complex(out, a, b, len);
 	else
 		neon_cmplx_mul_4n(out, a, b, len >> 2);
 #else
-	cmplx_mul_ps(out, a, b, len);
+	base_mul_complex(out, a, b, len);
 #endif
 }
@@ -29,30 +29,21 @@
 
 void neon_scale_4n(float *, float *, float *, int);
 
-static void scale_ps(float *out, float *in, float *scale, int len)
+/* API: Initialize scale module */
+void scale_init(void)
 {
-	float ai, aq, bi, bq;
-
-	bi = scale[0];
-	bq = scale[1];
-
-	for (int i = 0; i < len; i++) {
-		ai = in[2 * i + 0];
-		aq = in[2 * i + 1];
-
-		out[2 * i + 0] = ai * bi - aq * bq;
-		out[2 * i + 1] = ai * bq + aq * bi;
-	}
+	/* Stub */
+	return;
 }
 
 void scale_complex(float *out, float *in, float* scale, int len)
 {
 #ifdef HAVE_NEON
 	if (len % 4)
-		scale_ps(out, in, scale, len);
+		base_scale_complex(out, in, scale, len);
 	else
 		neon_scale_4n(in, scale, out, len >> 2);
 #else
-	scale_ps(out, in, scale, len);
+	base_scale_complex(out, in, scale, len);
 #endif
 }
@@ -0,0 +1,41 @@
+/*
+ * Burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "stats.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* API: Initialize statistics module */
+void stats_init(void)
+{
+	/* Stub */
+	return;
+}
+
+void burst_stats(const float *in, int len, int win,
+		 float *energy, float *peak)
+{
+	base_burst_stats(in, len, win, energy, peak);
+}
+
+int argmax_norm2(const float *in, int len, float *max)
+{
+	return base_argmax_norm2(in, len, max);
+}
@@ -0,0 +1,97 @@
+/*
+ * AArch64 NEON type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include "convert.h"
+#include "convert_neon.h"
+#include "hwcap.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Architecture dependent function pointers */
+struct convert_cpu_context {
+	void (*convert_si16_ps) (float *, const short *, int);
+	void (*convert_scale_ps_si16)(short *, const float *, float, int);
+	void (*convert_soft_ps_u8)(unsigned char *, const float *, int);
+	void (*convert_ps_planar)(float *, float *, const float *, int);
+	void (*convert_planar_ps)(float *, const float *, const float *, int);
+	void (*convert_ps_ph)(unsigned short *, const float *, int);
+	void (*convert_ph_ps)(float *, const unsigned short *, int);
+};
+
+static struct convert_cpu_context c;
+
+void convert_init(void)
+{
+	c.convert_scale_ps_si16 = base_convert_float_short;
+	c.convert_si16_ps = base_convert_short_float;
+	c.convert_soft_ps_u8 = base_convert_float_soft;
+	c.convert_ps_planar = base_convert_float_planar;
+	c.convert_planar_ps = base_convert_planar_float;
+	c.convert_ps_ph = base_convert_float_half;
+	c.convert_ph_ps = base_convert_half_float;
+
+	if (hwcap_has_asimd()) {
+		c.convert_scale_ps_si16 = neon_convert_scale_ps_si16;
+		c.convert_si16_ps = neon_convert_si16_ps;
+		c.convert_soft_ps_u8 = neon_convert_soft_ps_u8;
+		c.convert_ps_planar = neon_convert_ps_planar;
+		c.convert_planar_ps = neon_convert_planar_ps;
+		c.convert_ps_ph = neon_convert_ps_ph;
+		c.convert_ph_ps = neon_convert_ph_ps;
+	}
+}
+
+void convert_float_short(short *out, const float *in, float scale, int len)
+{
+	c.convert_scale_ps_si16(out, in, scale, len);
+}
+
+void convert_short_float(float *out, const short *in, int len)
+{
+	c.convert_si16_ps(out, in, len);
+}
+
+void convert_float_soft(unsigned char *out, const float *in, int len)
+{
+	c.convert_soft_ps_u8(out, in, len);
+}
+
+void convert_float_planar(float *re, float *im, const float *in, int len)
+{
+	c.convert_ps_planar(re, im, in, len);
+}
+
+void convert_planar_float(float *out, const float *re, const float *im,
+			  int len)
+{
+	c.convert_planar_ps(out, re, im, len);
+}
+
+void convert_float_half(unsigned short *out, const float *in, int len)
+{
+	c.convert_ps_ph(out, in, len);
+}
+
+void convert_half_float(float *out, const unsigned short *in, int len)
+{
+	c.convert_ph_ps(out, in, len);
+}
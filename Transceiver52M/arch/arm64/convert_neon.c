@@ -0,0 +1,173 @@
+/*
+ * AArch64 NEON type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include "convert.h"
+#include "convert_neon.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+/* Single precision floats scaled and converted with remainder */
+void neon_convert_scale_ps_si16(short *restrict out,
+				const float *restrict in,
+				float scale, int len)
+{
+	float32x4_t m0, m1;
+	int32x4_t m2, m3;
+	int i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		/* Scale */
+		m0 = vmulq_n_f32(vld1q_f32(&in[i + 0]), scale);
+		m1 = vmulq_n_f32(vld1q_f32(&in[i + 4]), scale);
+
+		/* Convert with rounding to nearest */
+		m2 = vcvtnq_s32_f32(m0);
+		m3 = vcvtnq_s32_f32(m1);
+
+		/* Saturating narrow and store */
+		vst1q_s16(&out[i], vcombine_s16(vqmovn_s32(m2), vqmovn_s32(m3)));
+	}
+
+	if (i < len)
+		base_convert_float_short(&out[i], &in[i], scale, len - i);
+}
+
+/* 16-bit signed integer converted to single precision floats */
+void neon_convert_si16_ps(float *restrict out,
+			  const short *restrict in, int len)
+{
+	int16x8_t m0;
+	int i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		m0 = vld1q_s16(&in[i]);
+
+		vst1q_f32(&out[i + 0],
+			  vcvtq_f32_s32(vmovl_s16(vget_low_s16(m0))));
+		vst1q_f32(&out[i + 4],
+			  vcvtq_f32_s32(vmovl_s16(vget_high_s16(m0))));
+	}
+
+	if (i < len)
+		base_convert_short_float(&out[i], &in[i], len - i);
+}
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void neon_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len)
+{
+	float32x4_t m0, m1, m2, m3, one;
+	uint16x8_t m4, m5;
+	int i;
+
+	one = vdupq_n_f32(1.0f);
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		/* Offset and scale -1..+1 onto 0..255 */
+		m0 = vmulq_n_f32(vaddq_f32(vld1q_f32(&in[i + 0]), one), 127.5f);
+		m1 = vmulq_n_f32(vaddq_f32(vld1q_f32(&in[i + 4]), one), 127.5f);
+		m2 = vmulq_n_f32(vaddq_f32(vld1q_f32(&in[i + 8]), one), 127.5f);
+		m3 = vmulq_n_f32(vaddq_f32(vld1q_f32(&in[i + 12]), one), 127.5f);
+
+		/* Convert with rounding to nearest, NaN converts to zero */
+		m4 = vcombine_u16(vqmovun_s32(vcvtnq_s32_f32(m0)),
+				  vqmovun_s32(vcvtnq_s32_f32(m1)));
+		m5 = vcombine_u16(vqmovun_s32(vcvtnq_s32_f32(m2)),
+				  vqmovun_s32(vcvtnq_s32_f32(m3)));
+
+		/* Saturating narrow and store */
+		vst1q_u8(&out[i], vcombine_u8(vqmovn_u16(m4), vqmovn_u16(m5)));
+	}
+
+	if (i < len)
+		base_convert_float_soft(&out[i], &in[i], len - i);
+}
+
+/* Complex floats split into real and imaginary arrays with remainder */
+void neon_convert_ps_planar(float *restrict re, float *restrict im,
+			    const float *restrict in, int len)
+{
+	float32x4x2_t m0;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		m0 = vld2q_f32(&in[2 * i]);
+		vst1q_f32(&re[i], m0.val[0]);
+		vst1q_f32(&im[i], m0.val[1]);
+	}
+
+	if (i < len)
+		base_convert_float_planar(&re[i], &im[i], &in[2 * i], len - i);
+}
+
+/* Real and imaginary arrays merged into complex floats with remainder */
+void neon_convert_planar_ps(float *restrict out, const float *restrict re,
+			    const float *restrict im, int len)
+{
+	float32x4x2_t m0;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		m0.val[0] = vld1q_f32(&re[i]);
+		m0.val[1] = vld1q_f32(&im[i]);
+		vst2q_f32(&out[2 * i], m0);
+	}
+
+	if (i < len)
+		base_convert_planar_float(&out[2 * i], &re[i], &im[i], len - i);
+}
+
+void neon_convert_ps_ph(unsigned short *restrict out,
+			const float *restrict in, int len)
+{
+	float16x4_t m0, m1;
+	int i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		m0 = vcvt_f16_f32(vld1q_f32(&in[i + 0]));
+		m1 = vcvt_f16_f32(vld1q_f32(&in[i + 4]));
+		vst1_u16(&out[i + 0], vreinterpret_u16_f16(m0));
+		vst1_u16(&out[i + 4], vreinterpret_u16_f16(m1));
+	}
+
+	if (i < len)
+		base_convert_float_half(&out[i], &in[i], len - i);
+}
+
+void neon_convert_ph_ps(float *restrict out,
+			const unsigned short *restrict in, int len)
+{
+	float16x4_t m0, m1;
+	int i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		m0 = vreinterpret_f16_u16(vld1_u16(&in[i + 0]));
+		m1 = vreinterpret_f16_u16(vld1_u16(&in[i + 4]));
+		vst1q_f32(&out[i + 0], vcvt_f32_f16(m0));
+		vst1q_f32(&out[i + 4], vcvt_f32_f16(m1));
+	}
+
+	if (i < len)
+		base_convert_half_float(&out[i], &in[i], len - i);
+}
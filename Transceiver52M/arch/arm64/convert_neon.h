@@ -0,0 +1,48 @@
+/*
+ * AArch64 NEON type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+/* Single precision floats scaled and converted with remainder */
+void neon_convert_scale_ps_si16(short *restrict out,
+				const float *restrict in,
+				float scale, int len);
+
+/* 16-bit signed integer converted to floats with remainder */
+void neon_convert_si16_ps(float *restrict out,
+			  const short *restrict in, int len);
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void neon_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len);
+
+/* Complex floats split into real and imaginary arrays with remainder */
+void neon_convert_ps_planar(float *restrict re, float *restrict im,
+			    const float *restrict in, int len);
+
+/* Real and imaginary arrays merged into complex floats with remainder */
+void neon_convert_planar_ps(float *restrict out, const float *restrict re,
+			    const float *restrict im, int len);
+
+/* Single precision floats converted to half precision with remainder */
+void neon_convert_ps_ph(unsigned short *restrict out,
+			const float *restrict in, int len);
+
+/* Half precision converted to single precision floats with remainder */
+void neon_convert_ph_ps(float *restrict out,
+			const unsigned short *restrict in, int len);
@@ -0,0 +1,283 @@
+/*
+ * AArch64 NEON Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include "convolve.h"
+#include "convolve_tune.h"
+#include "convolve_neon.h"
+#include "hwcap.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Architecture dependent function pointers */
+struct convolve_cpu_context {
+	int (*conv_cmplx) (const float *, int, const float *, int, float *,
+			   int, int, int);
+	int (*conv_real) (const float *, int, const float *, int, float *, int,
+			  int, int);
+	int (*conv_real_poly) (const float *, int, const float *, int,
+			       float *, int, const int *, const int *, int);
+	int (*conv_cmplx_planar) (const float *, const float *, int,
+				  const float *, const float *, int,
+				  float *, float *, int, int, int);
+	int (*conv_cmplx_planar_multi) (const float *, const float *, int,
+					const float *, const float *, int, int,
+					float *, float *, int, int, int);
+};
+static struct convolve_cpu_context c;
+
+/* Kernel candidates for the autotuner */
+#define CONV_KERNEL_MAX		8
+static struct conv_kernel kernels[CONV_KERNEL_MAX];
+static int num_kernels;
+
+/* Forward declarations from base implementation */
+int _base_convolve_real(const float *x, int x_len,
+			const float *h, int h_len,
+			float *y, int y_len,
+			int start, int len);
+
+int _base_convolve_complex(const float *x, int x_len,
+			   const float *h, int h_len,
+			   float *y, int y_len,
+			   int start, int len);
+
+int _base_convolve_real_polyphase(const float *x, int x_len,
+				  const float *h, int h_len,
+				  float *y, int y_len,
+				  const int *index, const int *path, int len);
+
+int _base_convolve_complex_planar(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len);
+
+int _base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+					int x_len,
+					const float *h_re, const float *h_im,
+					int h_len, int h_num,
+					float *y_re, float *y_im, int y_len,
+					int start, int len);
+
+int bounds_check(int x_len, int h_len, int y_len,
+		 int start, int len);
+
+int polyphase_bounds_check(int x_len, int h_len, int y_len,
+			   const int *index, int len);
+
+static struct conv_kernel *kernel_new(const char *name, enum conv_kind kind)
+{
+	struct conv_kernel *k;
+
+	if (num_kernels >= CONV_KERNEL_MAX)
+		return NULL;
+
+	k = &kernels[num_kernels++];
+	k->name = name;
+	k->kind = kind;
+	k->h_len = 0;
+	k->h_mod = 0;
+
+	return k;
+}
+
+static void kernel_add(const char *name, enum conv_kind kind,
+		       conv_kernel_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, kind);
+
+	if (k)
+		k->fn.conv = fn;
+}
+
+static void kernel_add_poly(const char *name, conv_poly_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, CONV_POLYPHASE);
+
+	if (k)
+		k->fn.poly = fn;
+}
+
+static void kernel_add_planar(const char *name, conv_planar_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, CONV_PLANAR);
+
+	if (k)
+		k->fn.planar = fn;
+}
+
+/* Every kernel usable on this CPU */
+static void kernel_init(void)
+{
+	num_kernels = 0;
+	conv_tune_reset();
+
+	kernel_add("base", CONV_REAL, _base_convolve_real);
+	kernel_add("base", CONV_COMPLEX, _base_convolve_complex);
+	kernel_add_poly("base", _base_convolve_real_polyphase);
+	kernel_add_planar("base", _base_convolve_complex_planar);
+
+	if (hwcap_has_asimd()) {
+		kernel_add("neon_real", CONV_REAL, neon_conv_real);
+		kernel_add("neon_cmplx", CONV_COMPLEX, neon_conv_cmplx);
+		kernel_add_poly("neon_poly", neon_conv_real_polyphase);
+		kernel_add_planar("neon_planar", neon_conv_cmplx_planar);
+	}
+}
+
+/* API: Initialize convolve module */
+void convolve_init(void)
+{
+	kernel_init();
+
+	c.conv_cmplx = _base_convolve_complex;
+	c.conv_real = _base_convolve_real;
+	c.conv_real_poly = _base_convolve_real_polyphase;
+	c.conv_cmplx_planar = _base_convolve_complex_planar;
+	c.conv_cmplx_planar_multi = _base_convolve_complex_planar_multi;
+
+	if (hwcap_has_asimd()) {
+		c.conv_cmplx = neon_conv_cmplx;
+		c.conv_real = neon_conv_real;
+		c.conv_real_poly = neon_conv_real_polyphase;
+		c.conv_cmplx_planar = neon_conv_cmplx_planar;
+		c.conv_cmplx_planar_multi = neon_conv_cmplx_planar_multi;
+	}
+}
+
+/* API: Aligned complex-real */
+int convolve_real(const float *x, int x_len,
+		  const float *h, int h_len,
+		  float *y, int y_len, int start, int len)
+{
+	const struct conv_kernel *k;
+
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	memset(y, 0, len * 2 * sizeof(float));
+
+	k = conv_tune_lookup(CONV_REAL, h_len);
+	if (k)
+		k->fn.conv(x, x_len, h, h_len, y, y_len, start, len);
+	else
+		c.conv_real(x, x_len, h, h_len, y, y_len, start, len);
+
+	return len;
+}
+
+/* API: Aligned complex-complex */
+int convolve_complex(const float *x, int x_len,
+		     const float *h, int h_len,
+		     float *y, int y_len,
+		     int start, int len)
+{
+	const struct conv_kernel *k;
+
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	memset(y, 0, len * 2 * sizeof(float));
+
+	k = conv_tune_lookup(CONV_COMPLEX, h_len);
+	if (k)
+		k->fn.conv(x, x_len, h, h_len, y, y_len, start, len);
+	else
+		c.conv_cmplx(x, x_len, h, h_len, y, y_len, start, len);
+
+	return len;
+}
+
+/* API: Polyphase complex-real */
+int convolve_real_polyphase(const float *x, int x_len,
+			    const float *h, int h_len,
+			    float *y, int y_len,
+			    const int *index, const int *path, int len)
+{
+	const struct conv_kernel *k;
+
+	if (polyphase_bounds_check(x_len, h_len, y_len, index, len) < 0)
+		return -1;
+
+	k = conv_tune_lookup(CONV_POLYPHASE, h_len);
+	if (k)
+		k->fn.poly(x, x_len, h, h_len, y, y_len,
+			   index, path, len);
+	else
+		c.conv_real_poly(x, x_len, h, h_len, y, y_len,
+				 index, path, len);
+
+	return len;
+}
+
+/* API: Time the usable kernels on a filter shape and select the fastest */
+const char *convolve_tune(enum conv_kind kind, int h_len, int len)
+{
+	return conv_tune_run(kernels, num_kernels, kind, h_len, len);
+}
+
+/* API: Select a kernel by name for a filter shape */
+int convolve_select(enum conv_kind kind, int h_len, const char *name)
+{
+	return conv_tune_select(kernels, num_kernels, kind, h_len, name);
+}
+
+/* API: Planar complex-complex */
+int convolve_complex_planar(const float *x_re, const float *x_im, int x_len,
+			    const float *h_re, const float *h_im, int h_len,
+			    float *y_re, float *y_im, int y_len,
+			    int start, int len)
+{
+	const struct conv_kernel *k;
+
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	k = conv_tune_lookup(CONV_PLANAR, h_len);
+	if (k)
+		k->fn.planar(x_re, x_im, x_len, h_re, h_im, h_len,
+			     y_re, y_im, y_len, start, len);
+	else
+		c.conv_cmplx_planar(x_re, x_im, x_len, h_re, h_im, h_len,
+				    y_re, y_im, y_len, start, len);
+
+	return len;
+}
+
+/* API: Planar complex-complex against h_num sequences of equal length */
+int convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len, int h_num,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	c.conv_cmplx_planar_multi(x_re, x_im, x_len, h_re, h_im, h_len, h_num,
+				  y_re, y_im, y_len, start, len);
+
+	return len;
+}
@@ -0,0 +1,387 @@
+/*
+ * AArch64 NEON Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include "convolve_neon.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+/*
+ * Input samples and taps are deinterleaved into I and Q vectors with the
+ * structure loads, four complex samples at a time. Taps that do not fill a
+ * whole vector are handled with a scalar tail so every h_len is supported.
+ */
+
+/* N-tap NEON complex-real convolution */
+int neon_conv_real(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_real() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_real(), which are: x_len, y_len. */
+
+	float32x4x2_t xv, hv;
+	float32x4_t acc_i, acc_q;
+	float sum_i, sum_q;
+	int n4 = h_len / 4 * 4;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (int i = 0; i < len; i++) {
+		acc_i = vdupq_n_f32(0.0f);
+		acc_q = vdupq_n_f32(0.0f);
+
+		for (int n = 0; n < n4; n += 4) {
+			hv = vld2q_f32(&h[2 * n]);
+			xv = vld2q_f32(&_x[2 * (i + n)]);
+
+			acc_i = vfmaq_f32(acc_i, xv.val[0], hv.val[0]);
+			acc_q = vfmaq_f32(acc_q, xv.val[1], hv.val[0]);
+		}
+
+		sum_i = vaddvq_f32(acc_i);
+		sum_q = vaddvq_f32(acc_q);
+
+		for (int n = n4; n < h_len; n++) {
+			sum_i += _x[2 * (i + n) + 0] * h[2 * n];
+			sum_q += _x[2 * (i + n) + 1] * h[2 * n];
+		}
+
+		y[2 * i + 0] = sum_i;
+		y[2 * i + 1] = sum_q;
+	}
+
+	return len;
+}
+
+/* N-tap NEON polyphase complex-real convolution */
+int neon_conv_real_polyphase(const float *x, int x_len,
+			     const float *h, int h_len,
+			     float *y, int y_len,
+			     const int *index, const int *path, int len)
+{
+	/* See NOTE in neon_conv_real() */
+
+	float32x4x2_t xv, hv;
+	float32x4_t acc_i, acc_q;
+	float sum_i, sum_q;
+	int n4 = h_len / 4 * 4;
+
+	for (int i = 0; i < len; i++) {
+		const float *_x = &x[2 * (index[i] - (h_len - 1))];
+		const float *_h = &h[2 * h_len * path[i]];
+
+		acc_i = vdupq_n_f32(0.0f);
+		acc_q = vdupq_n_f32(0.0f);
+
+		for (int n = 0; n < n4; n += 4) {
+			hv = vld2q_f32(&_h[2 * n]);
+			xv = vld2q_f32(&_x[2 * n]);
+
+			acc_i = vfmaq_f32(acc_i, xv.val[0], hv.val[0]);
+			acc_q = vfmaq_f32(acc_q, xv.val[1], hv.val[0]);
+		}
+
+		sum_i = vaddvq_f32(acc_i);
+		sum_q = vaddvq_f32(acc_q);
+
+		for (int n = n4; n < h_len; n++) {
+			sum_i += _x[2 * n + 0] * _h[2 * n];
+			sum_q += _x[2 * n + 1] * _h[2 * n];
+		}
+
+		y[2 * i + 0] = sum_i;
+		y[2 * i + 1] = sum_q;
+	}
+
+	return len;
+}
+
+/* N-tap NEON complex-complex convolution */
+int neon_conv_cmplx(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_complex() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_complex(), which are: x_len, y_len. */
+
+	float32x4x2_t xv, hv;
+	float32x4_t acc_i, acc_q;
+	float sum_i, sum_q;
+	int n4 = h_len / 4 * 4;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (int i = 0; i < len; i++) {
+		acc_i = vdupq_n_f32(0.0f);
+		acc_q = vdupq_n_f32(0.0f);
+
+		for (int n = 0; n < n4; n += 4) {
+			hv = vld2q_f32(&h[2 * n]);
+			xv = vld2q_f32(&_x[2 * (i + n)]);
+
+			/* (xi * hi - xq * hq) and (xi * hq + xq * hi) */
+			acc_i = vfmaq_f32(acc_i, xv.val[0], hv.val[0]);
+			acc_i = vfmsq_f32(acc_i, xv.val[1], hv.val[1]);
+			acc_q = vfmaq_f32(acc_q, xv.val[0], hv.val[1]);
+			acc_q = vfmaq_f32(acc_q, xv.val[1], hv.val[0]);
+		}
+
+		sum_i = vaddvq_f32(acc_i);
+		sum_q = vaddvq_f32(acc_q);
+
+		for (int n = n4; n < h_len; n++) {
+			const float *_xn = &_x[2 * (i + n)];
+
+			sum_i += _xn[0] * h[2 * n + 0] - _xn[1] * h[2 * n + 1];
+			sum_q += _xn[0] * h[2 * n + 1] + _xn[1] * h[2 * n + 0];
+		}
+
+		y[2 * i + 0] = sum_i;
+		y[2 * i + 1] = sum_q;
+	}
+
+	return len;
+}
+
+/* N-tap NEON planar complex-complex convolution */
+int neon_conv_cmplx_planar(const float *x_re, const float *x_im, int x_len,
+			   const float *h_re, const float *h_im, int h_len,
+			   float *y_re, float *y_im, int y_len,
+			   int start, int len)
+{
+	/*
+	 * Four outputs per vector with broadcast taps and separate accumulators
+	 * for each partial product, no lane permutes. Trailing outputs recompute
+	 * the last full block since results are stored, not accumulated.
+	 */
+
+	float32x4_t m0, m1, m4, m5;
+	float32x4_t rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1;
+	float32x4_t rr2, ii2, ri2, ir2, rr3, ii3, ri3, ir3;
+	int i;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (i = 0; i < len; i += 16) {
+		if (i + 16 > len) {
+			if (len < 16)
+				break;
+			i = len - 16;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = vdupq_n_f32(0.0f);
+		rr1 = ii1 = ri1 = ir1 = vdupq_n_f32(0.0f);
+		rr2 = ii2 = ri2 = ir2 = vdupq_n_f32(0.0f);
+		rr3 = ii3 = ri3 = ir3 = vdupq_n_f32(0.0f);
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = vdupq_n_f32(h_re[n]);
+			m5 = vdupq_n_f32(h_im[n]);
+			m0 = vld1q_f32(&_xr[i + n + 0]);
+			m1 = vld1q_f32(&_xi[i + n + 0]);
+			rr0 = vfmaq_f32(rr0, m0, m4);
+			ii0 = vfmaq_f32(ii0, m1, m5);
+			ri0 = vfmaq_f32(ri0, m0, m5);
+			ir0 = vfmaq_f32(ir0, m1, m4);
+			m0 = vld1q_f32(&_xr[i + n + 4]);
+			m1 = vld1q_f32(&_xi[i + n + 4]);
+			rr1 = vfmaq_f32(rr1, m0, m4);
+			ii1 = vfmaq_f32(ii1, m1, m5);
+			ri1 = vfmaq_f32(ri1, m0, m5);
+			ir1 = vfmaq_f32(ir1, m1, m4);
+			m0 = vld1q_f32(&_xr[i + n + 8]);
+			m1 = vld1q_f32(&_xi[i + n + 8]);
+			rr2 = vfmaq_f32(rr2, m0, m4);
+			ii2 = vfmaq_f32(ii2, m1, m5);
+			ri2 = vfmaq_f32(ri2, m0, m5);
+			ir2 = vfmaq_f32(ir2, m1, m4);
+			m0 = vld1q_f32(&_xr[i + n + 12]);
+			m1 = vld1q_f32(&_xi[i + n + 12]);
+			rr3 = vfmaq_f32(rr3, m0, m4);
+			ii3 = vfmaq_f32(ii3, m1, m5);
+			ri3 = vfmaq_f32(ri3, m0, m5);
+			ir3 = vfmaq_f32(ir3, m1, m4);
+		}
+
+		vst1q_f32(&y_re[i + 0], vsubq_f32(rr0, ii0));
+		vst1q_f32(&y_re[i + 4], vsubq_f32(rr1, ii1));
+		vst1q_f32(&y_re[i + 8], vsubq_f32(rr2, ii2));
+		vst1q_f32(&y_re[i + 12], vsubq_f32(rr3, ii3));
+		vst1q_f32(&y_im[i + 0], vaddq_f32(ri0, ir0));
+		vst1q_f32(&y_im[i + 4], vaddq_f32(ri1, ir1));
+		vst1q_f32(&y_im[i + 8], vaddq_f32(ri2, ir2));
+		vst1q_f32(&y_im[i + 12], vaddq_f32(ri3, ir3));
+	}
+
+	for (; i < len; i += 4) {
+		if (i + 4 > len) {
+			if (len < 4)
+				break;
+			i = len - 4;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = vdupq_n_f32(0.0f);
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = vdupq_n_f32(h_re[n]);
+			m5 = vdupq_n_f32(h_im[n]);
+			m0 = vld1q_f32(&_xr[i + n + 0]);
+			m1 = vld1q_f32(&_xi[i + n + 0]);
+			rr0 = vfmaq_f32(rr0, m0, m4);
+			ii0 = vfmaq_f32(ii0, m1, m5);
+			ri0 = vfmaq_f32(ri0, m0, m5);
+			ir0 = vfmaq_f32(ir0, m1, m4);
+		}
+
+		vst1q_f32(&y_re[i], vsubq_f32(rr0, ii0));
+		vst1q_f32(&y_im[i], vaddq_f32(ri0, ir0));
+	}
+
+	for (; i < len; i++) {
+		float sum_re = 0.0f, sum_im = 0.0f;
+
+		for (int n = 0; n < h_len; n++) {
+			sum_re += _xr[i + n] * h_re[n] - _xi[i + n] * h_im[n];
+			sum_im += _xr[i + n] * h_im[n] + _xi[i + n] * h_re[n];
+		}
+
+		y_re[i] = sum_re;
+		y_im[i] = sum_im;
+	}
+
+	return len;
+}
+
+/*
+ * N-tap NEON planar complex-complex convolution against multiple sequences
+ *
+ * Three sequences share every pair of input loads, eight outputs per block
+ * in 24 accumulators. One or two remaining sequences go through the single
+ * sequence kernel.
+ */
+int neon_conv_cmplx_planar_multi(const float *x_re, const float *x_im,
+				 int x_len,
+				 const float *h_re, const float *h_im,
+				 int h_len, int h_num,
+				 float *y_re, float *y_im, int y_len,
+				 int start, int len)
+{
+	float32x4_t m0, m1, m2, m3, m4, m5;
+	float32x4_t rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1;
+	float32x4_t rr2, ii2, ri2, ir2, rr3, ii3, ri3, ir3;
+	float32x4_t rr4, ii4, ri4, ir4, rr5, ii5, ri5, ir5;
+	int i, k;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (k = 0; k + 3 <= h_num && len >= 8; k += 3) {
+		const float *hr = &h_re[k * h_len];
+		const float *hi = &h_im[k * h_len];
+		float *yr = &y_re[k * y_len];
+		float *yi = &y_im[k * y_len];
+
+		for (i = 0; i < len; i += 8) {
+			if (i + 8 > len)
+				i = len - 8;
+
+			rr0 = ii0 = ri0 = ir0 = vdupq_n_f32(0.0f);
+			rr1 = ii1 = ri1 = ir1 = vdupq_n_f32(0.0f);
+			rr2 = ii2 = ri2 = ir2 = vdupq_n_f32(0.0f);
+			rr3 = ii3 = ri3 = ir3 = vdupq_n_f32(0.0f);
+			rr4 = ii4 = ri4 = ir4 = vdupq_n_f32(0.0f);
+			rr5 = ii5 = ri5 = ir5 = vdupq_n_f32(0.0f);
+
+			for (int n = 0; n < h_len; n++) {
+				m0 = vld1q_f32(&_xr[i + n + 0]);
+				m1 = vld1q_f32(&_xi[i + n + 0]);
+				m2 = vld1q_f32(&_xr[i + n + 4]);
+				m3 = vld1q_f32(&_xi[i + n + 4]);
+
+				m4 = vdupq_n_f32(hr[n]);
+				m5 = vdupq_n_f32(hi[n]);
+				rr0 = vfmaq_f32(rr0, m0, m4);
+				ii0 = vfmaq_f32(ii0, m1, m5);
+				ri0 = vfmaq_f32(ri0, m0, m5);
+				ir0 = vfmaq_f32(ir0, m1, m4);
+				rr1 = vfmaq_f32(rr1, m2, m4);
+				ii1 = vfmaq_f32(ii1, m3, m5);
+				ri1 = vfmaq_f32(ri1, m2, m5);
+				ir1 = vfmaq_f32(ir1, m3, m4);
+
+				m4 = vdupq_n_f32(hr[n + h_len]);
+				m5 = vdupq_n_f32(hi[n + h_len]);
+				rr2 = vfmaq_f32(rr2, m0, m4);
+				ii2 = vfmaq_f32(ii2, m1, m5);
+				ri2 = vfmaq_f32(ri2, m0, m5);
+				ir2 = vfmaq_f32(ir2, m1, m4);
+				rr3 = vfmaq_f32(rr3, m2, m4);
+				ii3 = vfmaq_f32(ii3, m3, m5);
+				ri3 = vfmaq_f32(ri3, m2, m5);
+				ir3 = vfmaq_f32(ir3, m3, m4);
+
+				m4 = vdupq_n_f32(hr[n + 2 * h_len]);
+				m5 = vdupq_n_f32(hi[n + 2 * h_len]);
+				rr4 = vfmaq_f32(rr4, m0, m4);
+				ii4 = vfmaq_f32(ii4, m1, m5);
+				ri4 = vfmaq_f32(ri4, m0, m5);
+				ir4 = vfmaq_f32(ir4, m1, m4);
+				rr5 = vfmaq_f32(rr5, m2, m4);
+				ii5 = vfmaq_f32(ii5, m3, m5);
+				ri5 = vfmaq_f32(ri5, m2, m5);
+				ir5 = vfmaq_f32(ir5, m3, m4);
+			}
+
+			vst1q_f32(&yr[i + 0], vsubq_f32(rr0, ii0));
+			vst1q_f32(&yr[i + 4], vsubq_f32(rr1, ii1));
+			vst1q_f32(&yi[i + 0], vaddq_f32(ri0, ir0));
+			vst1q_f32(&yi[i + 4], vaddq_f32(ri1, ir1));
+			vst1q_f32(&yr[y_len + i + 0], vsubq_f32(rr2, ii2));
+			vst1q_f32(&yr[y_len + i + 4], vsubq_f32(rr3, ii3));
+			vst1q_f32(&yi[y_len + i + 0], vaddq_f32(ri2, ir2));
+			vst1q_f32(&yi[y_len + i + 4], vaddq_f32(ri3, ir3));
+			vst1q_f32(&yr[2 * y_len + i + 0], vsubq_f32(rr4, ii4));
+			vst1q_f32(&yr[2 * y_len + i + 4], vsubq_f32(rr5, ii5));
+			vst1q_f32(&yi[2 * y_len + i + 0], vaddq_f32(ri4, ir4));
+			vst1q_f32(&yi[2 * y_len + i + 4], vaddq_f32(ri5, ir5));
+		}
+	}
+
+	for (; k < h_num; k++) {
+		neon_conv_cmplx_planar(x_re, x_im, x_len,
+				       &h_re[k * h_len], &h_im[k * h_len],
+				       h_len, &y_re[k * y_len],
+				       &y_im[k * y_len], y_len, start, len);
+	}
+
+	return len;
+}
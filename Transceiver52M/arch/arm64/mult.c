@@ -0,0 +1,46 @@
+/*
+ * AArch64 NEON complex multiplication
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mult.h"
+#include "mult_neon.h"
+#include "hwcap.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Architecture dependent function pointers */
+struct mult_cpu_context {
+	void (*mul_complex) (float *, float *, float *, int);
+};
+
+static struct mult_cpu_context c;
+
+/* API: Initialize mult module */
+void mult_init(void)
+{
+	c.mul_complex = base_mul_complex;
+
+	if (hwcap_has_asimd())
+		c.mul_complex = neon_mul_complex;
+}
+
+void mul_complex(float *out, float *a, float *b, int len)
+{
+	c.mul_complex(out, a, b, len);
+}
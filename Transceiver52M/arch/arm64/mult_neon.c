@@ -0,0 +1,49 @@
+/*
+ * AArch64 NEON complex multiplication
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mult.h"
+#include "mult_neon.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+/* Element-wise complex multiplication with remainder */
+void neon_mul_complex(float *out, float *a, float *b, int len)
+{
+	float32x4x2_t av, bv, y;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		av = vld2q_f32(&a[2 * i]);
+		bv = vld2q_f32(&b[2 * i]);
+
+		/* (ai * bi - aq * bq, ai * bq + aq * bi) */
+		y.val[0] = vmulq_f32(av.val[0], bv.val[0]);
+		y.val[0] = vfmsq_f32(y.val[0], av.val[1], bv.val[1]);
+		y.val[1] = vmulq_f32(av.val[0], bv.val[1]);
+		y.val[1] = vfmaq_f32(y.val[1], av.val[1], bv.val[0]);
+
+		vst2q_f32(&out[2 * i], y);
+	}
+
+	if (i < len)
+		base_mul_complex(&out[2 * i], &a[2 * i], &b[2 * i], len - i);
+}
@@ -0,0 +1,52 @@
+/*
+ * AArch64 NEON complex scaling
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "scale.h"
+#include "scale_neon.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+/* Complex vector scaled by a complex constant with remainder */
+void neon_scale_complex(float *out, float *in, float *scale, int len)
+{
+	float32x4x2_t a, y;
+	float32x4_t bi, bq;
+	int i;
+
+	bi = vdupq_n_f32(scale[0]);
+	bq = vdupq_n_f32(scale[1]);
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		a = vld2q_f32(&in[2 * i]);
+
+		/* (ai * bi - aq * bq, ai * bq + aq * bi) */
+		y.val[0] = vmulq_f32(a.val[0], bi);
+		y.val[0] = vfmsq_f32(y.val[0], a.val[1], bq);
+		y.val[1] = vmulq_f32(a.val[0], bq);
+		y.val[1] = vfmaq_f32(y.val[1], a.val[1], bi);
+
+		vst2q_f32(&out[2 * i], y);
+	}
+
+	if (i < len)
+		base_scale_complex(&out[2 * i], &in[2 * i], scale, len - i);
+}
@@ -0,0 +1,115 @@
+/*
+ * AArch64 NEON burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "stats.h"
+#include "stats_neon.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+/* Fused windowed energy and peak amplitude with remainder */
+void neon_burst_stats(const float *in, int len, int win,
+		      float *energy, float *peak)
+{
+	float32x4_t a, b, e, p, mask;
+	float _e, _p;
+	int i, n;
+
+	/* Energy lane mask for the first sample of each group */
+	mask = vcombine_f32(vdup_n_f32(1.0f), vdup_n_f32(0.0f));
+	e = vdupq_n_f32(0.0f);
+	p = vdupq_n_f32(0.0f);
+
+	n = len / 4 < win ? len / 4 : win;
+
+	/* Groups of four samples inside the energy window */
+	for (i = 0; i < 4 * n; i += 4) {
+		a = vld1q_f32(&in[2 * i + 0]);
+		b = vld1q_f32(&in[2 * i + 4]);
+
+		e = vfmaq_f32(e, vmulq_f32(a, mask), a);
+		p = vmaxq_f32(p, vabsq_f32(a));
+		p = vmaxq_f32(p, vabsq_f32(b));
+	}
+
+	/* Remaining groups contribute to the peak only */
+	for (; i + 4 <= len; i += 4) {
+		a = vld1q_f32(&in[2 * i + 0]);
+		b = vld1q_f32(&in[2 * i + 4]);
+
+		p = vmaxq_f32(p, vabsq_f32(a));
+		p = vmaxq_f32(p, vabsq_f32(b));
+	}
+
+	base_burst_stats(&in[2 * i], len - i, win - i / 4, &_e, &_p);
+
+	*energy = vaddvq_f32(e) + _e;
+	*peak = vmaxvq_f32(p) > _p ? vmaxvq_f32(p) : _p;
+}
+
+/* Index of maximum squared magnitude with remainder */
+int neon_argmax_norm2(const float *in, int len, float *max)
+{
+	float32x4x2_t a;
+	float32x4_t val, vmax, vidx, cur, four;
+	uint32x4_t gt;
+	float vals[4], idxs[4], m = 0.0f, tail;
+	int i, index = -1, k;
+
+	const float init[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+	vmax = vdupq_n_f32(0.0f);
+	vidx = vdupq_n_f32(-1.0f);
+	cur = vld1q_f32(init);
+	four = vdupq_n_f32(4.0f);
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		a = vld2q_f32(&in[2 * i]);
+		val = vaddq_f32(vmulq_f32(a.val[0], a.val[0]),
+				vmulq_f32(a.val[1], a.val[1]));
+
+		/* Strictly greater keeps the first index in each lane */
+		gt = vcgtq_f32(val, vmax);
+		vmax = vmaxq_f32(val, vmax);
+		vidx = vbslq_f32(gt, cur, vidx);
+		cur = vaddq_f32(cur, four);
+	}
+
+	vst1q_f32(vals, vmax);
+	vst1q_f32(idxs, vidx);
+
+	for (k = 0; k < 4; k++) {
+		if ((vals[k] > m) ||
+		    ((vals[k] == m) && (m > 0.0f) && ((int) idxs[k] < index))) {
+			m = vals[k];
+			index = (int) idxs[k];
+		}
+	}
+
+	k = base_argmax_norm2(&in[2 * i], len - i, &tail);
+	if (tail > m) {
+		m = tail;
+		index = i + k;
+	}
+
+	*max = m;
+	return index;
+}
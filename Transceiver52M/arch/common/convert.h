@@ -5,11 +5,34 @@ void convert_float_short(short *out, const float *in, float scale, int len);
 
 void convert_short_float(float *out, const short *in, int len);
 
+void convert_float_soft(unsigned char *out, const float *in, int len);
+
+void convert_float_planar(float *re, float *im, const float *in, int len);
+
+void convert_planar_float(float *out, const float *re, const float *im,
+			  int len);
+
+void convert_float_half(unsigned short *out, const float *in, int len);
+
+void convert_half_float(float *out, const unsigned short *in, int len);
+
 void base_convert_float_short(short *out, const float *in,
 			      float scale, int len);
 
 void base_convert_short_float(float *out, const short *in, int len);
 
+void base_convert_float_soft(unsigned char *out, const float *in, int len);
+
+void base_convert_float_planar(float *re, float *im, const float *in,
+			       int len);
+
+void base_convert_planar_float(float *out, const float *re, const float *im,
+			       int len);
+
+void base_convert_float_half(unsigned short *out, const float *in, int len);
+
+void base_convert_half_float(float *out, const unsigned short *in, int len);
+
 void convert_init(void);
 
 #endif /* _CONVERT_H_ */
@@ -19,6 +19,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <math.h>
+#include <stdint.h>
 #include "convert.h"
 
 void base_convert_float_short(short *out, const float *in,
@@ -33,3 +35,94 @@ void base_convert_short_float(float *out, const short *in, int len)
 	for (int i = 0; i < len; i++)
 		out[i] = in[i];
 }
+
+/* Soft bits in -1..+1 mapped to 0..255 with saturation */
+void base_convert_float_soft(unsigned char *out, const float *in, int len)
+{
+	float val;
+
+	for (int i = 0; i < len; i++) {
+		val = (in[i] + 1.0f) * 127.5f;
+		if (val > 255.0f)
+			val = 255.0f;
+		else if (!(val > 0.0f))
+			val = 0.0f;
+
+		out[i] = (unsigned char) lrintf(val);
+	}
+}
+
+/* Interleaved complex samples split into real and imaginary arrays */
+void base_convert_float_planar(float *re, float *im, const float *in,
+			       int len)
+{
+	for (int i = 0; i < len; i++) {
+		re[i] = in[2 * i + 0];
+		im[i] = in[2 * i + 1];
+	}
+}
+
+/* Real and imaginary arrays merged into interleaved complex samples */
+void base_convert_planar_float(float *out, const float *re, const float *im,
+			       int len)
+{
+	for (int i = 0; i < len; i++) {
+		out[2 * i + 0] = re[i];
+		out[2 * i + 1] = im[i];
+	}
+}
+
+/*
+ * IEEE 754 binary16 conversion with round to nearest even. Magnitudes that
+ * round beyond the largest half value become infinity, subnormals are kept.
+ */
+static unsigned short float_to_half(float f)
+{
+	union { float f; uint32_t u; } v = { .f = f };
+	uint32_t sign = (v.u >> 16) & 0x8000;
+	uint32_t mag = v.u & 0x7fffffff;
+
+	if (mag >= 0x477ff000) {
+		/* Infinity, overflow or NaN */
+		return sign | (mag > 0x7f800000 ? 0x7e00 : 0x7c00);
+	} else if (mag < 0x38800000) {
+		/* Subnormal, the addition performs the rounding */
+		v.u = mag;
+		v.f += 0.5f;
+		return sign | (v.u - 0x3f000000);
+	}
+
+	mag += ((uint32_t) (15 - 127) << 23) + 0xfff + ((mag >> 13) & 1);
+
+	return sign | (mag >> 13);
+}
+
+static float half_to_float(unsigned short h)
+{
+	union { float f; uint32_t u; } v;
+	uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+
+	if ((h & 0x7c00) == 0x7c00) {
+		v.u = sign | 0x7f800000 | ((uint32_t) (h & 0x03ff) << 13);
+	} else if (!(h & 0x7c00)) {
+		v.f = (h & 0x03ff) * (1.0f / 16777216.0f);
+		v.u |= sign;
+	} else {
+		v.u = sign | (((uint32_t) (h & 0x7fff) << 13) +
+			      ((uint32_t) (127 - 15) << 23));
+	}
+
+	return v.f;
+}
+
+void base_convert_float_half(unsigned short *out, const float *in, int len)
+{
+	for (int i = 0; i < len; i++)
+		out[i] = float_to_half(in[i]);
+}
+
+void base_convert_half_float(float *out, const unsigned short *in, int len)
+{
+	for (int i = 0; i < len; i++)
+		out[i] = half_to_float(in[i]);
+}
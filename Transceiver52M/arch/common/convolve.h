@@ -23,6 +23,62 @@ int base_convolve_complex(const float *x, int x_len,
 			  float *y, int y_len,
 			  int start, int len);
 
+int convolve_real_polyphase(const float *x, int x_len,
+			    const float *h, int h_len,
+			    float *y, int y_len,
+			    const int *index, const int *path, int len);
+
+int base_convolve_real_polyphase(const float *x, int x_len,
+				 const float *h, int h_len,
+				 float *y, int y_len,
+				 const int *index, const int *path, int len);
+
+int convolve_complex_planar(const float *x_re, const float *x_im, int x_len,
+			    const float *h_re, const float *h_im, int h_len,
+			    float *y_re, float *y_im, int y_len,
+			    int start, int len);
+
+int base_convolve_complex_planar(const float *x_re, const float *x_im,
+				 int x_len,
+				 const float *h_re, const float *h_im,
+				 int h_len,
+				 float *y_re, float *y_im, int y_len,
+				 int start, int len);
+
+int convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len, int h_num,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len);
+
+int base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				       int x_len,
+				       const float *h_re, const float *h_im,
+				       int h_len, int h_num,
+				       float *y_re, float *y_im, int y_len,
+				       int start, int len);
+
 void convolve_init(void);
 
+/* Filter shapes handled by the kernel autotuner */
+enum conv_kind {
+	CONV_REAL,
+	CONV_COMPLEX,
+	CONV_POLYPHASE,
+	CONV_PLANAR,
+};
+
+/* Kernel candidate set, bump when a candidate is added, removed or renamed */
+#define CONV_TUNE_VERSION	1
+
+const char *conv_kind_name(enum conv_kind kind);
+
+const char *convolve_tune(enum conv_kind kind, int h_len, int len);
+
+int convolve_select(enum conv_kind kind, int h_len, const char *name);
+
+int convolve_selected(int idx, enum conv_kind *kind, int *h_len,
+		      const char **name);
+
 #endif /* _CONVOLVE_H_ */
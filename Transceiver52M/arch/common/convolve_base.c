@@ -88,6 +88,76 @@ int _base_convolve_complex(const float *x, int x_len,
 	return len;
 }
 
+/* Base polyphase complex-real convolution */
+int _base_convolve_real_polyphase(const float *x, int x_len,
+				  const float *h, int h_len,
+				  float *y, int y_len,
+				  const int *index, const int *path, int len)
+{
+	for (int i = 0; i < len; i++) {
+		y[2 * i + 0] = 0.0f;
+		y[2 * i + 1] = 0.0f;
+
+		mac_real_vec_n(&x[2 * (index[i] - (h_len - 1))],
+			       &h[2 * h_len * path[i]],
+			       &y[2 * i], h_len);
+	}
+
+	return len;
+}
+
+/*
+ * Base planar complex-complex convolution. Real and imaginary parts of the
+ * input, taps and output are held in separate arrays. Output is stored, not
+ * accumulated.
+ */
+int _base_convolve_complex_planar(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len)
+{
+	for (int i = 0; i < len; i++) {
+		const float *_xr = &x_re[i - (h_len - 1) + start];
+		const float *_xi = &x_im[i - (h_len - 1) + start];
+		float sum_re = 0.0f, sum_im = 0.0f;
+
+		for (int n = 0; n < h_len; n++) {
+			sum_re += _xr[n] * h_re[n] - _xi[n] * h_im[n];
+			sum_im += _xr[n] * h_im[n] + _xi[n] * h_re[n];
+		}
+
+		y_re[i] = sum_re;
+		y_im[i] = sum_im;
+	}
+
+	return len;
+}
+
+/*
+ * Base planar convolution against h_num sequences of h_len taps each. Taps
+ * of sequence k start at h_re[k * h_len] and its outputs at y_re[k * y_len].
+ */
+int _base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+					int x_len,
+					const float *h_re, const float *h_im,
+					int h_len, int h_num,
+					float *y_re, float *y_im, int y_len,
+					int start, int len)
+{
+	for (int k = 0; k < h_num; k++) {
+		_base_convolve_complex_planar(x_re, x_im, x_len,
+					      &h_re[k * h_len],
+					      &h_im[k * h_len], h_len,
+					      &y_re[k * y_len],
+					      &y_im[k * y_len], y_len,
+					      start, len);
+	}
+
+	return len;
+}
+
 /* Buffer validity checks */
 int bounds_check(int x_len, int h_len, int y_len,
 		 int start, int len)
@@ -108,6 +178,26 @@ int bounds_check(int x_len, int h_len, int y_len,
 	return 0;
 }
 
+/* Polyphase buffer validity checks, input indices must be increasing */
+int polyphase_bounds_check(int x_len, int h_len, int y_len,
+			   const int *index, int len)
+{
+	if ((x_len < 1) || (h_len < 1) ||
+	    (y_len < 1) || (len < 1)) {
+		fprintf(stderr, "Convolve: Invalid input\n");
+		return -1;
+	}
+
+	if ((index[len - 1] >= x_len) || (len > y_len) || (x_len < h_len)) {
+		fprintf(stderr, "Convolve: Boundary exception\n");
+		fprintf(stderr, "last: %i, len: %i, x: %i, h: %i, y: %i\n",
+				index[len - 1], len, x_len, h_len, y_len);
+		return -1;
+	}
+
+	return 0;
+}
+
 /* API: Non-aligned (no SSE) complex-real */
 int base_convolve_real(const float *x, int x_len,
 		       const float *h, int h_len,
@@ -142,6 +232,55 @@ int base_convolve_complex(const float *x, int x_len,
 				      start, len);
 }
 
+/* API: Non-aligned (no SSE) polyphase complex-real */
+int base_convolve_real_polyphase(const float *x, int x_len,
+				 const float *h, int h_len,
+				 float *y, int y_len,
+				 const int *index, const int *path, int len)
+{
+	if (polyphase_bounds_check(x_len, h_len, y_len, index, len) < 0)
+		return -1;
+
+	return _base_convolve_real_polyphase(x, x_len,
+					     h, h_len,
+					     y, y_len,
+					     index, path, len);
+}
+
+/* API: Non-aligned (no SSE) planar complex-complex */
+int base_convolve_complex_planar(const float *x_re, const float *x_im,
+				 int x_len,
+				 const float *h_re, const float *h_im,
+				 int h_len,
+				 float *y_re, float *y_im, int y_len,
+				 int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	return _base_convolve_complex_planar(x_re, x_im, x_len,
+					     h_re, h_im, h_len,
+					     y_re, y_im, y_len,
+					     start, len);
+}
+
+/* API: Non-aligned (no SSE) planar complex-complex, multiple sequences */
+int base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				       int x_len,
+				       const float *h_re, const float *h_im,
+				       int h_len, int h_num,
+				       float *y_re, float *y_im, int y_len,
+				       int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	return _base_convolve_complex_planar_multi(x_re, x_im, x_len,
+						   h_re, h_im, h_len, h_num,
+						   y_re, y_im, y_len,
+						   start, len);
+}
+
 /* Aligned filter tap allocation */
 void *convolve_h_alloc(size_t len)
 {
@@ -0,0 +1,250 @@
+/*
+ * Convolution kernel autotuning
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <time.h>
+#include "convolve_tune.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/*
+ * The feature flag dispatch picks one kernel per tap count class. Which of
+ * the usable kernels is actually fastest depends on the filter length, the
+ * output length and the cache and vector unit of the machine. The tuner
+ * times every candidate on the filter shapes in use and records the winner
+ * per kind and tap count, which then takes precedence over the default
+ * dispatch. Selections are made once at startup, before any processing
+ * thread is running, and are not locked.
+ */
+#define TUNE_WORK		(1 << 18)	/* Taps times outputs per run */
+#define TUNE_ROUNDS		5
+#define TUNE_PATHS		4		/* Polyphase partitions */
+
+struct conv_sel {
+	enum conv_kind kind;
+	int h_len;
+	const struct conv_kernel *k;
+};
+
+static struct conv_sel sel[CONV_TUNE_MAX];
+static int num_sel;
+
+static int conv_kernel_fits(const struct conv_kernel *k,
+			    enum conv_kind kind, int h_len)
+{
+	if (k->kind != kind)
+		return 0;
+	if (k->h_len && (k->h_len != h_len))
+		return 0;
+	if (k->h_mod && (h_len % k->h_mod))
+		return 0;
+
+	return 1;
+}
+
+static int conv_tune_store(enum conv_kind kind, int h_len,
+			   const struct conv_kernel *k)
+{
+	for (int i = 0; i < num_sel; i++) {
+		if ((sel[i].kind == kind) && (sel[i].h_len == h_len)) {
+			sel[i].k = k;
+			return 0;
+		}
+	}
+
+	if (num_sel >= CONV_TUNE_MAX)
+		return -1;
+
+	sel[num_sel].kind = kind;
+	sel[num_sel].h_len = h_len;
+	sel[num_sel].k = k;
+	num_sel++;
+
+	return 0;
+}
+
+static double tune_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Best of several rounds to reject scheduling noise */
+static double tune_time(const struct conv_kernel *k,
+			const float *x, int x_len, const float *h, int h_len,
+			float *y, const int *index, const int *path,
+			int len, int iter)
+{
+	double t, best = -1.0;
+
+	for (int r = 0; r < TUNE_ROUNDS; r++) {
+		t = tune_now();
+		for (int i = 0; i < iter; i++) {
+			if (k->kind == CONV_POLYPHASE) {
+				k->fn.poly(x, x_len, h, h_len, y, len,
+					   index, path, len);
+			} else if (k->kind == CONV_PLANAR) {
+				k->fn.planar(x, &x[x_len], x_len,
+					     h, &h[h_len], h_len,
+					     y, &y[len], len, h_len - 1, len);
+			} else {
+				memset(y, 0, len * 2 * sizeof(float));
+				k->fn.conv(x, x_len, h, h_len, y, len,
+					   h_len - 1, len);
+			}
+		}
+		t = tune_now() - t;
+
+		if ((best < 0.0) || (t < best))
+			best = t;
+	}
+
+	return best;
+}
+
+/* Reset all selections back to the feature flag dispatch */
+void conv_tune_reset(void)
+{
+	num_sel = 0;
+}
+
+/* Tuned kernel for a filter shape or NULL for the default dispatch */
+const struct conv_kernel *conv_tune_lookup(enum conv_kind kind, int h_len)
+{
+	for (int i = 0; i < num_sel; i++) {
+		if ((sel[i].kind == kind) && (sel[i].h_len == h_len))
+			return sel[i].k;
+	}
+
+	return NULL;
+}
+
+/* Time all fitting candidates and select the fastest */
+const char *conv_tune_run(const struct conv_kernel *k, int num,
+			  enum conv_kind kind, int h_len, int len)
+{
+	const struct conv_kernel *best = NULL;
+	float *x = NULL, *h = NULL, *y = NULL;
+	int *index = NULL, *path = NULL;
+	int x_len, iter, fits = 0;
+	double t, best_t = 0.0;
+
+	if ((h_len < 1) || (len < 1))
+		return NULL;
+
+	for (int i = 0; i < num; i++)
+		fits += conv_kernel_fits(&k[i], kind, h_len);
+	if (!fits)
+		return NULL;
+
+	x_len = len + h_len;
+	iter = TUNE_WORK / (h_len * len) + 1;
+
+	x = (float *) memalign(64, 2 * x_len * sizeof(float));
+	h = (float *) memalign(64, 2 * h_len * TUNE_PATHS * sizeof(float));
+	y = (float *) memalign(64, 2 * len * sizeof(float));
+	index = (int *) malloc(len * sizeof(int));
+	path = (int *) malloc(len * sizeof(int));
+	if (!x || !h || !y || !index || !path)
+		goto release;
+
+	for (int i = 0; i < 2 * x_len; i++)
+		x[i] = (float) ((i * 7919) % 127) / 127.0f - 0.5f;
+	for (int i = 0; i < h_len * TUNE_PATHS; i++) {
+		h[2 * i + 0] = 1.0f / (i + 1);
+		h[2 * i + 1] = (kind == CONV_COMPLEX) ? 0.5f / (i + 1) : 0.0f;
+	}
+	for (int i = 0; i < len; i++) {
+		index[i] = h_len - 1 + i;
+		path[i] = i % TUNE_PATHS;
+	}
+
+	for (int i = 0; i < num; i++) {
+		if (!conv_kernel_fits(&k[i], kind, h_len))
+			continue;
+
+		t = tune_time(&k[i], x, x_len, h, h_len, y,
+			      index, path, len, iter);
+		if (!best || (t < best_t)) {
+			best = &k[i];
+			best_t = t;
+		}
+	}
+
+	if (conv_tune_store(kind, h_len, best) < 0)
+		best = NULL;
+
+release:
+	free(x);
+	free(h);
+	free(y);
+	free(index);
+	free(path);
+
+	return best ? best->name : NULL;
+}
+
+/* Select a candidate by name, e.g. from a previously saved tuning run */
+int conv_tune_select(const struct conv_kernel *k, int num,
+		     enum conv_kind kind, int h_len, const char *name)
+{
+	for (int i = 0; i < num; i++) {
+		if (!conv_kernel_fits(&k[i], kind, h_len))
+			continue;
+		if (!strcmp(k[i].name, name))
+			return conv_tune_store(kind, h_len, &k[i]);
+	}
+
+	return -1;
+}
+
+/* API: Name of a filter kind as used in the tuning table */
+const char *conv_kind_name(enum conv_kind kind)
+{
+	switch (kind) {
+	case CONV_REAL:
+		return "real";
+	case CONV_COMPLEX:
+		return "complex";
+	case CONV_POLYPHASE:
+		return "polyphase";
+	case CONV_PLANAR:
+		return "planar";
+	}
+
+	return "unknown";
+}
+
+/* API: Enumerate the tuned kernel selections */
+int convolve_selected(int idx, enum conv_kind *kind, int *h_len,
+		      const char **name)
+{
+	if ((idx < 0) || (idx >= num_sel))
+		return -1;
+
+	*kind = sel[idx].kind;
+	*h_len = sel[idx].h_len;
+	*name = sel[idx].k->name;
+
+	return 0;
+}
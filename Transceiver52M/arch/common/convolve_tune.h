@@ -0,0 +1,55 @@
+/*
+ * Convolution kernel autotuning
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+#include "convolve.h"
+
+/* Maximum number of filter shapes with a tuned kernel */
+#define CONV_TUNE_MAX		32
+
+typedef int (*conv_kernel_fn) (const float *, int, const float *, int,
+			       float *, int, int, int);
+typedef int (*conv_poly_fn) (const float *, int, const float *, int,
+			     float *, int, const int *, const int *, int);
+typedef int (*conv_planar_fn) (const float *, const float *, int,
+			       const float *, const float *, int,
+			       float *, float *, int, int, int);
+
+/* Kernel candidate, the valid union member depends on the kind */
+struct conv_kernel {
+	const char *name;
+	enum conv_kind kind;
+	int h_len;		/* Required tap count, zero for any */
+	int h_mod;		/* Required tap count multiple, zero for any */
+	union {
+		conv_kernel_fn conv;	/* CONV_REAL, CONV_COMPLEX */
+		conv_poly_fn poly;	/* CONV_POLYPHASE */
+		conv_planar_fn planar;	/* CONV_PLANAR */
+	} fn;
+};
+
+void conv_tune_reset(void);
+
+const struct conv_kernel *conv_tune_lookup(enum conv_kind kind, int h_len);
+
+const char *conv_tune_run(const struct conv_kernel *k, int num,
+			  enum conv_kind kind, int h_len, int len);
+
+int conv_tune_select(const struct conv_kernel *k, int num,
+		     enum conv_kind kind, int h_len, const char *name);
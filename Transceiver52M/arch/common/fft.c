@@ -112,3 +112,20 @@ int cxvec_fft(struct fft_hdl *hdl)
 	fftwf_execute(hdl->fft_plan);
 	return 0;
 }
+
+/*! \brief Run the initialized plan on caller supplied buffers
+ *  \param[in] hdl handle to an initialized fft struct
+ *  \param[in] in input buffer (FFTW aligned)
+ *  \param[out] out output buffer (FFTW aligned)
+ *
+ * Buffers must have the same layout as those passed to init_fft() and must
+ * not alias unless the plan was created in-place. Unlike cxvec_fft(), the
+ * same handle may be executed concurrently from multiple threads as long as
+ * each thread supplies its own buffers.
+ */
+int cxvec_fft_buf(struct fft_hdl *hdl, float *in, float *out)
+{
+	fftwf_execute_dft(hdl->fft_plan,
+			  (fftwf_complex *) in, (fftwf_complex *) out);
+	return 0;
+}
@@ -9,5 +9,6 @@ void *fft_malloc(size_t size);
 void fft_free(void *ptr);
 void free_fft(struct fft_hdl *hdl);
 int cxvec_fft(struct fft_hdl *hdl);
+int cxvec_fft_buf(struct fft_hdl *hdl, float *in, float *out);
 
 #endif /* _FFT_H_ */
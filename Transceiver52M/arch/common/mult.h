@@ -3,4 +3,8 @@
 
 void mul_complex(float *out, float *a, float *b, int len);
 
+void base_mul_complex(float *out, float *a, float *b, int len);
+
+void mult_init(void);
+
 #endif /* _MULT_H_ */
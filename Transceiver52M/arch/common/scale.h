@@ -3,4 +3,8 @@
 
 void scale_complex(float *out, float *in, float *scale, int len);
 
+void base_scale_complex(float *out, float *in, float *scale, int len);
+
+void scale_init(void);
+
 #endif /* _SCALE_H_ */
@@ -0,0 +1,16 @@
+#ifndef _STATS_H_
+#define _STATS_H_
+
+void burst_stats(const float *in, int len, int win,
+		 float *energy, float *peak);
+
+int argmax_norm2(const float *in, int len, float *max);
+
+void base_burst_stats(const float *in, int len, int win,
+		      float *energy, float *peak);
+
+int base_argmax_norm2(const float *in, int len, float *max);
+
+void stats_init(void);
+
+#endif /* _STATS_H_ */
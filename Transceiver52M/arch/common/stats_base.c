@@ -0,0 +1,65 @@
+/*
+ * Burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <math.h>
+#include "stats.h"
+
+/*
+ * Single pass over a complex burst. Energy is the sum of the squared
+ * magnitude of every 4th sample over the first win of them, peak is the
+ * largest absolute value of any I or Q component.
+ */
+void base_burst_stats(const float *in, int len, int win,
+		      float *energy, float *peak)
+{
+	float e = 0.0f, p = 0.0f;
+
+	for (int i = 0; i < len; i++) {
+		if (!(i % 4) && (i / 4 < win))
+			e += in[2 * i + 0] * in[2 * i + 0] +
+			     in[2 * i + 1] * in[2 * i + 1];
+
+		p = fmaxf(p, fabsf(in[2 * i + 0]));
+		p = fmaxf(p, fabsf(in[2 * i + 1]));
+	}
+
+	*energy = e;
+	*peak = p;
+}
+
+/*
+ * Index of the first sample with the largest squared magnitude. Returns -1
+ * and a zero maximum if no sample has non-zero power.
+ */
+int base_argmax_norm2(const float *in, int len, float *max)
+{
+	float val, m = 0.0f;
+	int index = -1;
+
+	for (int i = 0; i < len; i++) {
+		val = in[2 * i + 0] * in[2 * i + 0] +
+		      in[2 * i + 1] * in[2 * i + 1];
+		if (val > m) {
+			m = val;
+			index = i;
+		}
+	}
+
+	*max = m;
+	return index;
+}
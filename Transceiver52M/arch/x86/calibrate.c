@@ -0,0 +1,143 @@
+/*
+ * x86 SIMD tier calibration
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <time.h>
+#include "calibrate.h"
+#include "convolve_sse_3.h"
+#include "convolve_avx2.h"
+#include "convolve_avx512.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/*
+ * Wide vector units on some x86 parts run at a reduced clock while executing
+ * 512-bit instructions, which can cost more than the wider lanes gain and
+ * also slows down the code running after the kernels. Time a representative
+ * convolution with the best narrower kernel, then with the AVX-512 kernel,
+ * then with the narrower kernel again. The AVX-512 tier is only enabled if
+ * it is faster and the narrower kernel did not slow down after it ran.
+ */
+#define CALIB_TAPS		16
+#define CALIB_LEN		625
+#define CALIB_ITER		64
+#define CALIB_ROUNDS		5
+#define CALIB_THROTTLE_RATIO	1.10
+
+/* Cached result, negative until the calibration has been run */
+static int avx512_usable = -1;
+
+#if defined(HAVE_AVX512) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+typedef int (*calib_kernel) (const float *, int, const float *, int,
+			     float *, int, int, int);
+
+static double calib_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Best of several rounds to reject scheduling noise */
+static double calib_run(calib_kernel fn, const float *x, const float *h,
+			float *y)
+{
+	double t, best = -1.0;
+
+	for (int r = 0; r < CALIB_ROUNDS; r++) {
+		t = calib_now();
+		for (int i = 0; i < CALIB_ITER; i++) {
+			fn(x, CALIB_LEN + CALIB_TAPS, h, CALIB_TAPS,
+			   y, CALIB_LEN, CALIB_TAPS - 1, CALIB_LEN);
+		}
+		t = calib_now() - t;
+
+		if ((best < 0.0) || (t < best))
+			best = t;
+	}
+
+	return best;
+}
+
+static int calibrate_avx512(void)
+{
+	calib_kernel ref = NULL;
+	float *x, *h, *y;
+	double t0, t1, t2;
+	int rc = 0;
+
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		ref = avx_conv_real4n;
+#endif
+#ifdef HAVE_SSE3
+	if (!ref && __builtin_cpu_supports("sse3"))
+		ref = sse_conv_real4n;
+#endif
+	/* Nothing to compare against, the wider kernels can only help */
+	if (!ref)
+		return 1;
+
+	x = (float *) memalign(64, 2 * (CALIB_LEN + CALIB_TAPS) * sizeof(float));
+	h = (float *) memalign(64, 2 * CALIB_TAPS * sizeof(float));
+	y = (float *) memalign(64, 2 * CALIB_LEN * sizeof(float));
+	if (!x || !h || !y)
+		goto release;
+
+	for (int i = 0; i < 2 * (CALIB_LEN + CALIB_TAPS); i++)
+		x[i] = (float) ((i * 7919) % 127) / 127.0f - 0.5f;
+	for (int i = 0; i < CALIB_TAPS; i++) {
+		h[2 * i + 0] = 1.0f / (i + 1);
+		h[2 * i + 1] = 0.0f;
+	}
+
+	t0 = calib_run(ref, x, h, y);
+	t1 = calib_run(avx512_conv_real, x, h, y);
+	t2 = calib_run(ref, x, h, y);
+
+	rc = (t1 < t0) && (t2 < t0 * CALIB_THROTTLE_RATIO);
+
+release:
+	free(x);
+	free(h);
+	free(y);
+
+	return rc;
+}
+#endif
+
+/* API: Check if the AVX-512 dispatch tier should be used */
+int calibrate_avx512_usable(void)
+{
+	if (avx512_usable >= 0)
+		return avx512_usable;
+
+	avx512_usable = 0;
+
+#if defined(HAVE_AVX512) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (__builtin_cpu_supports("avx512f") &&
+	    __builtin_cpu_supports("avx512vl"))
+		avx512_usable = calibrate_avx512();
+#endif
+
+	return avx512_usable;
+}
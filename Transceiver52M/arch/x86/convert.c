@@ -22,6 +22,9 @@
 #include "convert.h"
 #include "convert_sse_3.h"
 #include "convert_sse_4_1.h"
+#include "convert_avx2.h"
+#include "convert_avx512.h"
+#include "calibrate.h"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -34,6 +37,11 @@ struct convert_cpu_context {
 	void (*convert_scale_ps_si16_16n)(short *, const float *, float, int);
 	void (*convert_scale_ps_si16_8n)(short *, const float *, float, int);
 	void (*convert_scale_ps_si16)(short *, const float *, float, int);
+	void (*convert_soft_ps_u8)(unsigned char *, const float *, int);
+	void (*convert_ps_planar)(float *, float *, const float *, int);
+	void (*convert_planar_ps)(float *, const float *, const float *, int);
+	void (*convert_ps_ph)(unsigned short *, const float *, int);
+	void (*convert_ph_ps)(float *, const unsigned short *, int);
 };
 
 static struct convert_cpu_context c;
@@ -45,6 +53,11 @@ void convert_init(void)
 	c.convert_scale_ps_si16 = base_convert_float_short;
 	c.convert_si16_ps_16n = base_convert_short_float;
 	c.convert_si16_ps = base_convert_short_float;
+	c.convert_soft_ps_u8 = base_convert_float_soft;
+	c.convert_ps_planar = base_convert_float_planar;
+	c.convert_planar_ps = base_convert_planar_float;
+	c.convert_ps_ph = base_convert_float_half;
+	c.convert_ph_ps = base_convert_half_float;
 
 #ifdef HAVE___BUILTIN_CPU_SUPPORTS
 #ifdef HAVE_SSE4_1
@@ -59,6 +72,27 @@ void convert_init(void)
 		c.convert_scale_ps_si16_16n = _sse_convert_scale_ps_si16_16n;
 		c.convert_scale_ps_si16_8n = _sse_convert_scale_ps_si16_8n;
 		c.convert_scale_ps_si16 = _sse_convert_scale_ps_si16;
+		c.convert_soft_ps_u8 = _sse_convert_soft_ps_u8;
+		c.convert_ps_planar = _sse_convert_ps_planar;
+		c.convert_planar_ps = _sse_convert_planar_ps;
+	}
+#endif
+
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		c.convert_soft_ps_u8 = _avx_convert_soft_ps_u8;
+		c.convert_ps_ph = _avx_convert_ps_ph;
+		c.convert_ph_ps = _avx_convert_ph_ps;
+	}
+#endif
+
+#ifdef HAVE_AVX512
+	if (calibrate_avx512_usable()) {
+		c.convert_si16_ps_16n = _avx512_convert_si16_ps;
+		c.convert_si16_ps = _avx512_convert_si16_ps;
+		c.convert_scale_ps_si16_16n = _avx512_convert_scale_ps_si16;
+		c.convert_scale_ps_si16_8n = _avx512_convert_scale_ps_si16;
+		c.convert_scale_ps_si16 = _avx512_convert_scale_ps_si16;
 	}
 #endif
 #endif
@@ -81,3 +115,29 @@ void convert_short_float(float *out, const short *in, int len)
 	else
 		c.convert_si16_ps(out, in, len);
 }
+
+void convert_float_soft(unsigned char *out, const float *in, int len)
+{
+	c.convert_soft_ps_u8(out, in, len);
+}
+
+void convert_float_planar(float *re, float *im, const float *in, int len)
+{
+	c.convert_ps_planar(re, im, in, len);
+}
+
+void convert_planar_float(float *out, const float *re, const float *im,
+			  int len)
+{
+	c.convert_planar_ps(out, re, im, len);
+}
+
+void convert_float_half(unsigned short *out, const float *in, int len)
+{
+	c.convert_ps_ph(out, in, len);
+}
+
+void convert_half_float(float *out, const unsigned short *in, int len)
+{
+	c.convert_ph_ps(out, in, len);
+}
@@ -0,0 +1,115 @@
+/*
+ * AVX2 type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "convert.h"
+#include "convert_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void _avx_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len)
+{
+	__m256 m0, m1, m2, m3, m4, m5, m6, m7;
+	__m256i m8, m9, m10, m11, perm;
+	int i;
+
+	/* Offset and scale -1..+1 onto 0..255 */
+	m4 = _mm256_set1_ps(1.0f);
+	m5 = _mm256_set1_ps(127.5f);
+	m6 = _mm256_setzero_ps();
+	m7 = _mm256_set1_ps(255.0f);
+
+	/* Undo the in-lane interleave of the pack instructions */
+	perm = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	for (i = 0; i + 32 <= len; i += 32) {
+		/* Load (unaligned) input */
+		m0 = _mm256_loadu_ps(&in[i + 0]);
+		m1 = _mm256_loadu_ps(&in[i + 8]);
+		m2 = _mm256_loadu_ps(&in[i + 16]);
+		m3 = _mm256_loadu_ps(&in[i + 24]);
+
+		m0 = _mm256_mul_ps(_mm256_add_ps(m0, m4), m5);
+		m1 = _mm256_mul_ps(_mm256_add_ps(m1, m4), m5);
+		m2 = _mm256_mul_ps(_mm256_add_ps(m2, m4), m5);
+		m3 = _mm256_mul_ps(_mm256_add_ps(m3, m4), m5);
+
+		/* Clamp first so out of range and NaN values saturate */
+		m0 = _mm256_min_ps(_mm256_max_ps(m0, m6), m7);
+		m1 = _mm256_min_ps(_mm256_max_ps(m1, m6), m7);
+		m2 = _mm256_min_ps(_mm256_max_ps(m2, m6), m7);
+		m3 = _mm256_min_ps(_mm256_max_ps(m3, m6), m7);
+
+		/* Convert and pack */
+		m8 = _mm256_cvtps_epi32(m0);
+		m9 = _mm256_cvtps_epi32(m1);
+		m10 = _mm256_cvtps_epi32(m2);
+		m11 = _mm256_cvtps_epi32(m3);
+
+		m8 = _mm256_packs_epi32(m8, m9);
+		m10 = _mm256_packs_epi32(m10, m11);
+		m8 = _mm256_packus_epi16(m8, m10);
+
+		_mm256_storeu_si256((__m256i *) &out[i],
+				    _mm256_permutevar8x32_epi32(m8, perm));
+	}
+
+	if (i < len)
+		base_convert_float_soft(&out[i], &in[i], len - i);
+}
+
+void _avx_convert_ps_ph(unsigned short *restrict out,
+			const float *restrict in, int len)
+{
+	__m256 m0, m1;
+	int i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		m0 = _mm256_loadu_ps(&in[i + 0]);
+		m1 = _mm256_loadu_ps(&in[i + 8]);
+		_mm_storeu_si128((__m128i *) &out[i + 0],
+				 _mm256_cvtps_ph(m0, _MM_FROUND_TO_NEAREST_INT));
+		_mm_storeu_si128((__m128i *) &out[i + 8],
+				 _mm256_cvtps_ph(m1, _MM_FROUND_TO_NEAREST_INT));
+	}
+
+	base_convert_float_half(&out[i], &in[i], len - i);
+}
+
+void _avx_convert_ph_ps(float *restrict out,
+			const unsigned short *restrict in, int len)
+{
+	__m128i m0, m1;
+	int i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		m0 = _mm_loadu_si128((const __m128i *) &in[i + 0]);
+		m1 = _mm_loadu_si128((const __m128i *) &in[i + 8]);
+		_mm256_storeu_ps(&out[i + 0], _mm256_cvtph_ps(m0));
+		_mm256_storeu_ps(&out[i + 8], _mm256_cvtph_ps(m1));
+	}
+
+	base_convert_half_float(&out[i], &in[i], len - i);
+}
+#endif
@@ -0,0 +1,30 @@
+/*
+ * AVX2 type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void _avx_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len);
+
+/* Half precision conversion with F16C, every AVX2 capable CPU has it */
+void _avx_convert_ps_ph(unsigned short *restrict out,
+			const float *restrict in, int len);
+
+void _avx_convert_ph_ps(float *restrict out,
+			const unsigned short *restrict in, int len);
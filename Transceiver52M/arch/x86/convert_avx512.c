@@ -0,0 +1,83 @@
+/*
+ * AVX-512 type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include "convert_avx512.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX512
+#include <immintrin.h>
+
+/* Single precision floats scaled and converted to 16-bit signed integer */
+void _avx512_convert_scale_ps_si16(short *restrict out,
+				   const float *restrict in,
+				   float scale, int len)
+{
+	__m512 m0, m1;
+	__mmask16 k;
+	int i;
+
+	m1 = _mm512_set1_ps(scale);
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		/* Load (unaligned), scale and convert with saturation */
+		m0 = _mm512_mul_ps(_mm512_loadu_ps(&in[i]), m1);
+		_mm256_storeu_si256((__m256i *) &out[i],
+				    _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(m0)));
+	}
+
+	/* Masked remainder */
+	if (i < len) {
+		k = (__mmask16) ((1 << (len - i)) - 1);
+		m0 = _mm512_mul_ps(_mm512_maskz_loadu_ps(k, &in[i]), m1);
+		_mm512_mask_cvtsepi32_storeu_epi16(&out[i], k,
+						   _mm512_cvtps_epi32(m0));
+	}
+}
+
+/* 16-bit signed integer converted to single precision floats */
+void _avx512_convert_si16_ps(float *restrict out,
+			     const short *restrict in, int len)
+{
+	__m256i m0;
+	__mmask16 k;
+	short tail[16];
+	int i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		m0 = _mm256_loadu_si256((const __m256i *) &in[i]);
+		_mm512_storeu_ps(&out[i],
+				 _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(m0)));
+	}
+
+	/* Masked remainder, 16-bit masked loads would require AVX-512BW */
+	if (i < len) {
+		k = (__mmask16) ((1 << (len - i)) - 1);
+		memset(tail, 0, sizeof(tail));
+		memcpy(tail, &in[i], (len - i) * sizeof(short));
+
+		m0 = _mm256_loadu_si256((const __m256i *) tail);
+		_mm512_mask_storeu_ps(&out[i], k,
+				_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(m0)));
+	}
+}
+#endif
@@ -0,0 +1,28 @@
+/*
+ * AVX-512 type conversions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+/* Single precision floats scaled and converted with masked remainder */
+void _avx512_convert_scale_ps_si16(short *restrict out,
+				   const float *restrict in,
+				   float scale, int len);
+
+/* 16-bit signed integer converted to floats with masked remainder */
+void _avx512_convert_si16_ps(float *restrict out,
+			     const short *restrict in, int len);
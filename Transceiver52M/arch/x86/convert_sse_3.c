@@ -19,6 +19,7 @@
 
 #include <malloc.h>
 #include <string.h>
+#include "convert.h"
 #include "convert_sse_3.h"
 
 #ifdef HAVE_CONFIG_H
@@ -104,4 +105,92 @@ void _sse_convert_scale_ps_si16_16n(short *restrict out,
 		_mm_storeu_si128((__m128i *) & out[16 * i + 8], m7);
 	}
 }
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void _sse_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len)
+{
+	__m128 m0, m1, m2, m3, m4, m5, m6, m7;
+	__m128i m8, m9, m10, m11;
+	int i;
+
+	/* Offset and scale -1..+1 onto 0..255 */
+	m4 = _mm_set1_ps(1.0f);
+	m5 = _mm_set1_ps(127.5f);
+	m6 = _mm_setzero_ps();
+	m7 = _mm_set1_ps(255.0f);
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		/* Load (unaligned) input */
+		m0 = _mm_loadu_ps(&in[i + 0]);
+		m1 = _mm_loadu_ps(&in[i + 4]);
+		m2 = _mm_loadu_ps(&in[i + 8]);
+		m3 = _mm_loadu_ps(&in[i + 12]);
+
+		m0 = _mm_mul_ps(_mm_add_ps(m0, m4), m5);
+		m1 = _mm_mul_ps(_mm_add_ps(m1, m4), m5);
+		m2 = _mm_mul_ps(_mm_add_ps(m2, m4), m5);
+		m3 = _mm_mul_ps(_mm_add_ps(m3, m4), m5);
+
+		/* Clamp first so out of range and NaN values saturate */
+		m0 = _mm_min_ps(_mm_max_ps(m0, m6), m7);
+		m1 = _mm_min_ps(_mm_max_ps(m1, m6), m7);
+		m2 = _mm_min_ps(_mm_max_ps(m2, m6), m7);
+		m3 = _mm_min_ps(_mm_max_ps(m3, m6), m7);
+
+		/* Convert and pack */
+		m8 = _mm_cvtps_epi32(m0);
+		m9 = _mm_cvtps_epi32(m1);
+		m10 = _mm_cvtps_epi32(m2);
+		m11 = _mm_cvtps_epi32(m3);
+
+		m8 = _mm_packs_epi32(m8, m9);
+		m10 = _mm_packs_epi32(m10, m11);
+
+		_mm_storeu_si128((__m128i *) &out[i], _mm_packus_epi16(m8, m10));
+	}
+
+	if (i < len)
+		base_convert_float_soft(&out[i], &in[i], len - i);
+}
+
+/* Complex floats split into real and imaginary arrays with remainder */
+void _sse_convert_ps_planar(float *restrict re, float *restrict im,
+			    const float *restrict in, int len)
+{
+	__m128 m0, m1;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		/* Load (unaligned) input */
+		m0 = _mm_loadu_ps(&in[2 * i + 0]);
+		m1 = _mm_loadu_ps(&in[2 * i + 4]);
+
+		_mm_storeu_ps(&re[i], _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(&im[i], _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+
+	if (i < len)
+		base_convert_float_planar(&re[i], &im[i], &in[2 * i], len - i);
+}
+
+/* Real and imaginary arrays merged into complex floats with remainder */
+void _sse_convert_planar_ps(float *restrict out, const float *restrict re,
+			    const float *restrict im, int len)
+{
+	__m128 m0, m1;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		/* Load (unaligned) input */
+		m0 = _mm_loadu_ps(&re[i]);
+		m1 = _mm_loadu_ps(&im[i]);
+
+		_mm_storeu_ps(&out[2 * i + 0], _mm_unpacklo_ps(m0, m1));
+		_mm_storeu_ps(&out[2 * i + 4], _mm_unpackhi_ps(m0, m1));
+	}
+
+	if (i < len)
+		base_convert_planar_float(&out[2 * i], &re[i], &im[i], len - i);
+}
 #endif
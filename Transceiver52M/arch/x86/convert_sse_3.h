@@ -32,3 +32,15 @@ void _sse_convert_scale_ps_si16(short *restrict out,
 void _sse_convert_scale_ps_si16_16n(short *restrict out,
 				    const float *restrict in,
 				    float scale, int len);
+
+/* Soft bits converted to 8-bit unsigned integer with remainder */
+void _sse_convert_soft_ps_u8(unsigned char *restrict out,
+			     const float *restrict in, int len);
+
+/* Complex floats split into real and imaginary arrays with remainder */
+void _sse_convert_ps_planar(float *restrict re, float *restrict im,
+			    const float *restrict in, int len);
+
+/* Real and imaginary arrays merged into complex floats with remainder */
+void _sse_convert_planar_ps(float *restrict out, const float *restrict re,
+			    const float *restrict im, int len);
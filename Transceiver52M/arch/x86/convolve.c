@@ -21,7 +21,11 @@
 #include <string.h>
 #include <stdio.h>
 #include "convolve.h"
+#include "convolve_tune.h"
 #include "convolve_sse_3.h"
+#include "convolve_avx2.h"
+#include "convolve_avx512.h"
+#include "calibrate.h"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -29,29 +33,44 @@
 
 /* Architecture dependent function pointers */
 struct convolve_cpu_context {
-	void (*conv_cmplx_4n) (const float *, int, const float *, int, float *,
-			       int, int, int);
-	void (*conv_cmplx_8n) (const float *, int, const float *, int, float *,
-			       int, int, int);
-	void (*conv_cmplx) (const float *, int, const float *, int, float *,
+	int (*conv_cmplx_4n) (const float *, int, const float *, int, float *,
+			      int, int, int);
+	int (*conv_cmplx_8n) (const float *, int, const float *, int, float *,
+			      int, int, int);
+	int (*conv_cmplx) (const float *, int, const float *, int, float *,
+			   int, int, int);
+	int (*conv_real4) (const float *, int, const float *, int, float *,
+			   int, int, int);
+	int (*conv_real8) (const float *, int, const float *, int, float *,
+			   int, int, int);
+	int (*conv_real12) (const float *, int, const float *, int, float *,
 			    int, int, int);
-	void (*conv_real4) (const float *, int, const float *, int, float *,
+	int (*conv_real16) (const float *, int, const float *, int, float *,
 			    int, int, int);
-	void (*conv_real8) (const float *, int, const float *, int, float *,
+	int (*conv_real20) (const float *, int, const float *, int, float *,
 			    int, int, int);
-	void (*conv_real12) (const float *, int, const float *, int, float *,
-			     int, int, int);
-	void (*conv_real16) (const float *, int, const float *, int, float *,
-			     int, int, int);
-	void (*conv_real20) (const float *, int, const float *, int, float *,
-			     int, int, int);
-	void (*conv_real4n) (const float *, int, const float *, int, float *,
-			     int, int, int);
-	void (*conv_real) (const float *, int, const float *, int, float *, int,
-			   int, int);
+	int (*conv_real4n) (const float *, int, const float *, int, float *,
+			    int, int, int);
+	int (*conv_real) (const float *, int, const float *, int, float *, int,
+			  int, int);
+	int (*conv_real_poly4n) (const float *, int, const float *, int,
+				 float *, int, const int *, const int *, int);
+	int (*conv_real_poly) (const float *, int, const float *, int,
+			       float *, int, const int *, const int *, int);
+	int (*conv_cmplx_planar) (const float *, const float *, int,
+				  const float *, const float *, int,
+				  float *, float *, int, int, int);
+	int (*conv_cmplx_planar_multi) (const float *, const float *, int,
+					const float *, const float *, int, int,
+					float *, float *, int, int, int);
 };
 static struct convolve_cpu_context c;
 
+/* Kernel candidates for the autotuner */
+#define CONV_KERNEL_MAX		40
+static struct conv_kernel kernels[CONV_KERNEL_MAX];
+static int num_kernels;
+
 /* Forward declarations from base implementation */
 int _base_convolve_real(const float *x, int x_len,
 			const float *h, int h_len,
@@ -63,22 +82,150 @@ int _base_convolve_complex(const float *x, int x_len,
 			   float *y, int y_len,
 			   int start, int len);
 
+int _base_convolve_real_polyphase(const float *x, int x_len,
+				  const float *h, int h_len,
+				  float *y, int y_len,
+				  const int *index, const int *path, int len);
+
+int _base_convolve_complex_planar(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len);
+
+int _base_convolve_complex_planar_multi(const float *x_re, const float *x_im,
+					int x_len,
+					const float *h_re, const float *h_im,
+					int h_len, int h_num,
+					float *y_re, float *y_im, int y_len,
+					int start, int len);
+
 int bounds_check(int x_len, int h_len, int y_len,
 		 int start, int len);
 
+int polyphase_bounds_check(int x_len, int h_len, int y_len,
+			   const int *index, int len);
+
+static struct conv_kernel *kernel_new(const char *name, enum conv_kind kind,
+				       int h_len, int h_mod)
+{
+	struct conv_kernel *k;
+
+	if (num_kernels >= CONV_KERNEL_MAX)
+		return NULL;
+
+	k = &kernels[num_kernels++];
+	k->name = name;
+	k->kind = kind;
+	k->h_len = h_len;
+	k->h_mod = h_mod;
+
+	return k;
+}
+
+static void kernel_add(const char *name, enum conv_kind kind,
+		       int h_len, int h_mod, conv_kernel_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, kind, h_len, h_mod);
+
+	if (k)
+		k->fn.conv = fn;
+}
+
+static void kernel_add_poly(const char *name, int h_len, int h_mod,
+			    conv_poly_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, CONV_POLYPHASE, h_len, h_mod);
+
+	if (k)
+		k->fn.poly = fn;
+}
+
+static void kernel_add_planar(const char *name, int h_len, int h_mod,
+			      conv_planar_fn fn)
+{
+	struct conv_kernel *k = kernel_new(name, CONV_PLANAR, h_len, h_mod);
+
+	if (k)
+		k->fn.planar = fn;
+}
+
+/* Every kernel usable on this CPU, including the ones not dispatched */
+static void kernel_init(void)
+{
+	num_kernels = 0;
+	conv_tune_reset();
+
+	kernel_add("base", CONV_REAL, 0, 0, _base_convolve_real);
+	kernel_add("base", CONV_COMPLEX, 0, 0, _base_convolve_complex);
+	kernel_add_poly("base", 0, 0, _base_convolve_real_polyphase);
+	kernel_add_planar("base", 0, 0, _base_convolve_complex_planar);
+
+#if defined(HAVE_SSE3) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (__builtin_cpu_supports("sse3")) {
+		kernel_add("sse3_real4", CONV_REAL, 4, 0, sse_conv_real4);
+		kernel_add("sse3_real8", CONV_REAL, 8, 0, sse_conv_real8);
+		kernel_add("sse3_real12", CONV_REAL, 12, 0, sse_conv_real12);
+		kernel_add("sse3_real16", CONV_REAL, 16, 0, sse_conv_real16);
+		kernel_add("sse3_real20", CONV_REAL, 20, 0, sse_conv_real20);
+		kernel_add("sse3_real4n", CONV_REAL, 0, 4, sse_conv_real4n);
+		kernel_add("sse3_cmplx4n", CONV_COMPLEX, 0, 4,
+			   sse_conv_cmplx_4n);
+		kernel_add("sse3_cmplx8n", CONV_COMPLEX, 0, 8,
+			   sse_conv_cmplx_8n);
+		kernel_add_poly("sse3_poly4n", 0, 4, sse_conv_real4n_polyphase);
+		kernel_add_planar("sse3_planar", 0, 0, sse_conv_cmplx_planar);
+	}
+#endif
+
+#if defined(HAVE_AVX2) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		kernel_add("avx2_real4", CONV_REAL, 4, 0, avx_conv_real4);
+		kernel_add("avx2_real8", CONV_REAL, 8, 0, avx_conv_real8);
+		kernel_add("avx2_real12", CONV_REAL, 12, 0, avx_conv_real12);
+		kernel_add("avx2_real16", CONV_REAL, 16, 0, avx_conv_real16);
+		kernel_add("avx2_real20", CONV_REAL, 20, 0, avx_conv_real20);
+		kernel_add("avx2_real4n", CONV_REAL, 0, 4, avx_conv_real4n);
+		kernel_add("avx2_cmplx4n", CONV_COMPLEX, 0, 4,
+			   avx_conv_cmplx_4n);
+		kernel_add("avx2_cmplx8n", CONV_COMPLEX, 0, 8,
+			   avx_conv_cmplx_8n);
+		kernel_add_poly("avx2_poly4n", 0, 4, avx_conv_real4n_polyphase);
+		kernel_add_planar("avx2_planar", 0, 0, avx_conv_cmplx_planar);
+	}
+#endif
+
+#if defined(HAVE_AVX512) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (calibrate_avx512_usable()) {
+		kernel_add("avx512_real", CONV_REAL, 0, 0, avx512_conv_real);
+		kernel_add("avx512_cmplx", CONV_COMPLEX, 0, 0,
+			   avx512_conv_cmplx);
+		kernel_add_poly("avx512_poly", 0, 0,
+				avx512_conv_real_polyphase);
+	}
+#endif
+}
+
 /* API: Initialize convolve module */
 void convolve_init(void)
 {
-	c.conv_cmplx_4n = (void *)_base_convolve_complex;
-	c.conv_cmplx_8n = (void *)_base_convolve_complex;
-	c.conv_cmplx = (void *)_base_convolve_complex;
-	c.conv_real4 = (void *)_base_convolve_real;
-	c.conv_real8 = (void *)_base_convolve_real;
-	c.conv_real12 = (void *)_base_convolve_real;
-	c.conv_real16 = (void *)_base_convolve_real;
-	c.conv_real20 = (void *)_base_convolve_real;
-	c.conv_real4n = (void *)_base_convolve_real;
-	c.conv_real = (void *)_base_convolve_real;
+	kernel_init();
+
+	c.conv_cmplx_4n = _base_convolve_complex;
+	c.conv_cmplx_8n = _base_convolve_complex;
+	c.conv_cmplx = _base_convolve_complex;
+	c.conv_real4 = _base_convolve_real;
+	c.conv_real8 = _base_convolve_real;
+	c.conv_real12 = _base_convolve_real;
+	c.conv_real16 = _base_convolve_real;
+	c.conv_real20 = _base_convolve_real;
+	c.conv_real4n = _base_convolve_real;
+	c.conv_real = _base_convolve_real;
+	c.conv_real_poly4n = _base_convolve_real_polyphase;
+	c.conv_real_poly = _base_convolve_real_polyphase;
+	c.conv_cmplx_planar = _base_convolve_complex_planar;
+	c.conv_cmplx_planar_multi = _base_convolve_complex_planar_multi;
 
 #if defined(HAVE_SSE3) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
 	if (__builtin_cpu_supports("sse3")) {
@@ -90,6 +237,40 @@ void convolve_init(void)
 		c.conv_real16 = sse_conv_real16;
 		c.conv_real20 = sse_conv_real20;
 		c.conv_real4n = sse_conv_real4n;
+		c.conv_real_poly4n = sse_conv_real4n_polyphase;
+		c.conv_cmplx_planar = sse_conv_cmplx_planar;
+		c.conv_cmplx_planar_multi = sse_conv_cmplx_planar_multi;
+	}
+#endif
+
+#if defined(HAVE_AVX2) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		c.conv_cmplx_4n = avx_conv_cmplx_4n;
+		c.conv_cmplx_8n = avx_conv_cmplx_8n;
+		c.conv_real4 = avx_conv_real4;
+		c.conv_real8 = avx_conv_real8;
+		c.conv_real12 = avx_conv_real12;
+		c.conv_real16 = avx_conv_real16;
+		c.conv_real20 = avx_conv_real20;
+		c.conv_real4n = avx_conv_real4n;
+		c.conv_real_poly4n = avx_conv_real4n_polyphase;
+		c.conv_cmplx_planar = avx_conv_cmplx_planar;
+		c.conv_cmplx_planar_multi = avx_conv_cmplx_planar_multi;
+	}
+#endif
+
+	/* Short filters fit the AVX2 registers, everything else goes wide */
+#if defined(HAVE_AVX512) && defined(HAVE___BUILTIN_CPU_SUPPORTS)
+	if (calibrate_avx512_usable()) {
+		c.conv_cmplx_4n = avx512_conv_cmplx;
+		c.conv_cmplx_8n = avx512_conv_cmplx;
+		c.conv_cmplx = avx512_conv_cmplx;
+		c.conv_real16 = avx512_conv_real;
+		c.conv_real20 = avx512_conv_real;
+		c.conv_real4n = avx512_conv_real;
+		c.conv_real = avx512_conv_real;
+		c.conv_real_poly4n = avx512_conv_real_polyphase;
+		c.conv_real_poly = avx512_conv_real_polyphase;
 	}
 #endif
 }
@@ -99,11 +280,18 @@ int convolve_real(const float *x, int x_len,
 		  const float *h, int h_len,
 		  float *y, int y_len, int start, int len)
 {
+	const struct conv_kernel *k;
+
 	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
 		return -1;
 
 	memset(y, 0, len * 2 * sizeof(float));
 
+	if ((k = conv_tune_lookup(CONV_REAL, h_len))) {
+		k->fn.conv(x, x_len, h, h_len, y, y_len, start, len);
+		return len;
+	}
+
 	switch (h_len) {
 	case 4:
 		c.conv_real4(x, x_len, h, h_len, y, y_len, start, len);
@@ -138,11 +326,18 @@ int convolve_complex(const float *x, int x_len,
 		     float *y, int y_len,
 		     int start, int len)
 {
+	const struct conv_kernel *k;
+
 	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
 		return -1;
 
 	memset(y, 0, len * 2 * sizeof(float));
 
+	if ((k = conv_tune_lookup(CONV_COMPLEX, h_len))) {
+		k->fn.conv(x, x_len, h, h_len, y, y_len, start, len);
+		return len;
+	}
+
 	if (!(h_len % 8))
 		c.conv_cmplx_8n(x, x_len, h, h_len, y, y_len, start, len);
 	else if (!(h_len % 4))
@@ -152,3 +347,88 @@ int convolve_complex(const float *x, int x_len,
 
 	return len;
 }
+
+/*
+ * API: Polyphase complex-real
+ *
+ * Filter partitions of h_len taps each are stored back to back in h. Output
+ * sample i is the convolution of x, ending at index[i], with partition
+ * path[i]. All outputs of a resampler block are computed in a single call.
+ */
+int convolve_real_polyphase(const float *x, int x_len,
+			    const float *h, int h_len,
+			    float *y, int y_len,
+			    const int *index, const int *path, int len)
+{
+	const struct conv_kernel *k;
+
+	if (polyphase_bounds_check(x_len, h_len, y_len, index, len) < 0)
+		return -1;
+
+	if ((k = conv_tune_lookup(CONV_POLYPHASE, h_len))) {
+		k->fn.poly(x, x_len, h, h_len, y, y_len,
+			   index, path, len);
+		return len;
+	}
+
+	if (!(h_len % 4))
+		c.conv_real_poly4n(x, x_len, h, h_len, y, y_len,
+				   index, path, len);
+	else
+		c.conv_real_poly(x, x_len, h, h_len, y, y_len,
+				 index, path, len);
+
+	return len;
+}
+
+/* API: Time the usable kernels on a filter shape and select the fastest */
+const char *convolve_tune(enum conv_kind kind, int h_len, int len)
+{
+	return conv_tune_run(kernels, num_kernels, kind, h_len, len);
+}
+
+/* API: Select a kernel by name for a filter shape */
+int convolve_select(enum conv_kind kind, int h_len, const char *name)
+{
+	return conv_tune_select(kernels, num_kernels, kind, h_len, name);
+}
+
+/* API: Planar complex-complex */
+int convolve_complex_planar(const float *x_re, const float *x_im, int x_len,
+			    const float *h_re, const float *h_im, int h_len,
+			    float *y_re, float *y_im, int y_len,
+			    int start, int len)
+{
+	const struct conv_kernel *k;
+
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	if ((k = conv_tune_lookup(CONV_PLANAR, h_len))) {
+		k->fn.planar(x_re, x_im, x_len, h_re, h_im, h_len,
+			     y_re, y_im, y_len, start, len);
+		return len;
+	}
+
+	c.conv_cmplx_planar(x_re, x_im, x_len, h_re, h_im, h_len,
+			    y_re, y_im, y_len, start, len);
+
+	return len;
+}
+
+/* API: Planar complex-complex against h_num sequences of equal length */
+int convolve_complex_planar_multi(const float *x_re, const float *x_im,
+				  int x_len,
+				  const float *h_re, const float *h_im,
+				  int h_len, int h_num,
+				  float *y_re, float *y_im, int y_len,
+				  int start, int len)
+{
+	if (bounds_check(x_len, h_len, y_len, start, len) < 0)
+		return -1;
+
+	c.conv_cmplx_planar_multi(x_re, x_im, x_len, h_re, h_im, h_len, h_num,
+				  y_re, y_im, y_len, start, len);
+
+	return len;
+}
@@ -0,0 +1,589 @@
+/*
+ * AVX2 Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include "convolve_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+
+/*
+ * The AVX2 kernels operate directly on interleaved I/Q samples. Each 256-bit
+ * register holds four complex input samples, which are multiplied against
+ * four taps that are duplicated into the I and Q lanes. This avoids the
+ * deinterleaving shuffles of the SSE kernels. Output samples are computed in
+ * groups of four so that the horizontal reduction of the accumulators is
+ * shared and the results are written with a single store.
+ */
+
+/* Horizontal sum of four complex values into the lower half of an SSE reg */
+static inline __m128 avx_hsum_cmplx(__m256 m)
+{
+	__m128 m0, m1;
+
+	m0 = _mm256_castps256_ps128(m);
+	m1 = _mm256_extractf128_ps(m, 1);
+	m0 = _mm_add_ps(m0, m1);
+	m1 = _mm_movehl_ps(m0, m0);
+
+	return _mm_add_ps(m0, m1);
+}
+
+/* Horizontal sums of four accumulators into four consecutive outputs */
+static inline __m256 avx_hsum_cmplx4(__m256 a0, __m256 a1,
+				     __m256 a2, __m256 a3)
+{
+	__m256 m0, m1;
+
+	m0 = _mm256_add_ps(_mm256_permute2f128_ps(a0, a2, 0x20),
+			   _mm256_permute2f128_ps(a0, a2, 0x31));
+	m1 = _mm256_add_ps(_mm256_permute2f128_ps(a1, a3, 0x20),
+			   _mm256_permute2f128_ps(a1, a3, 0x31));
+
+	return _mm256_add_ps(_mm256_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 1, 0)),
+			     _mm256_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+/* Load four real taps, stored as complex, duplicated into I and Q lanes */
+static inline __m256 avx_load_real_taps(const float *h)
+{
+	return _mm256_moveldup_ps(_mm256_loadu_ps(h));
+}
+
+/* Complex-real convolution with a compile time constant 4*N taps */
+static inline void avx_conv_real_n(const float *_x, const float *h,
+				   float *y, int len, const int n)
+{
+	__m256 t[5], a0, a1, a2, a3;
+	int i = 0;
+
+	for (int k = 0; k < n; k++)
+		t[k] = avx_load_real_taps(&h[8 * k]);
+
+	for (; i + 4 <= len; i += 4) {
+		a0 = _mm256_mul_ps(_mm256_loadu_ps(&_x[2 * i + 0]), t[0]);
+		a1 = _mm256_mul_ps(_mm256_loadu_ps(&_x[2 * i + 2]), t[0]);
+		a2 = _mm256_mul_ps(_mm256_loadu_ps(&_x[2 * i + 4]), t[0]);
+		a3 = _mm256_mul_ps(_mm256_loadu_ps(&_x[2 * i + 6]), t[0]);
+
+		for (int k = 1; k < n; k++) {
+			const float *_xk = &_x[2 * i + 8 * k];
+
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xk[0]), t[k], a0);
+			a1 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xk[2]), t[k], a1);
+			a2 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xk[4]), t[k], a2);
+			a3 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xk[6]), t[k], a3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i], avx_hsum_cmplx4(a0, a1, a2, a3));
+	}
+
+	for (; i < len; i++) {
+		a0 = _mm256_mul_ps(_mm256_loadu_ps(&_x[2 * i]), t[0]);
+
+		for (int k = 1; k < n; k++) {
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[2 * i + 8 * k]),
+					     t[k], a0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i], avx_hsum_cmplx(a0));
+	}
+}
+
+/* 4-tap AVX2 complex-real convolution */
+int avx_conv_real4(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_real() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_real(), which are: x_len, y_len. */
+
+	avx_conv_real_n(&x[2 * (-(h_len - 1) + start)], h, y, len, 1);
+
+	return len;
+}
+
+/* 8-tap AVX2 complex-real convolution */
+int avx_conv_real8(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	avx_conv_real_n(&x[2 * (-(h_len - 1) + start)], h, y, len, 2);
+
+	return len;
+}
+
+/* 12-tap AVX2 complex-real convolution */
+int avx_conv_real12(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	avx_conv_real_n(&x[2 * (-(h_len - 1) + start)], h, y, len, 3);
+
+	return len;
+}
+
+/* 16-tap AVX2 complex-real convolution */
+int avx_conv_real16(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	avx_conv_real_n(&x[2 * (-(h_len - 1) + start)], h, y, len, 4);
+
+	return len;
+}
+
+/* 20-tap AVX2 complex-real convolution */
+int avx_conv_real20(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	avx_conv_real_n(&x[2 * (-(h_len - 1) + start)], h, y, len, 5);
+
+	return len;
+}
+
+/* 4*N-tap AVX2 complex-real convolution */
+int avx_conv_real4n(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	__m256 m0, a0, a1, a2, a3;
+	int i = 0;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (; i + 4 <= len; i += 4) {
+		/* Zero */
+		a0 = _mm256_setzero_ps();
+		a1 = _mm256_setzero_ps();
+		a2 = _mm256_setzero_ps();
+		a3 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 4; n++) {
+			const float *_xn = &_x[2 * i + 8 * n];
+
+			m0 = avx_load_real_taps(&h[8 * n]);
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xn[0]), m0, a0);
+			a1 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xn[2]), m0, a1);
+			a2 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xn[4]), m0, a2);
+			a3 = _mm256_fmadd_ps(_mm256_loadu_ps(&_xn[6]), m0, a3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i], avx_hsum_cmplx4(a0, a1, a2, a3));
+	}
+
+	for (; i < len; i++) {
+		a0 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 4; n++) {
+			m0 = avx_load_real_taps(&h[8 * n]);
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[2 * i + 8 * n]),
+					     m0, a0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i], avx_hsum_cmplx(a0));
+	}
+
+	return len;
+}
+
+/* 4*N-tap AVX2 polyphase complex-real convolution */
+int avx_conv_real4n_polyphase(const float *x, int x_len,
+			      const float *h, int h_len,
+			      float *y, int y_len,
+			      const int *index, const int *path, int len)
+{
+	/* See NOTE in avx_conv_real4() */
+
+	__m256 a0, a1, a2, a3;
+	int i = 0;
+
+	const float *_x = &x[2 * -(h_len - 1)];
+
+	/* Four outputs, each with its own input offset and filter partition */
+	for (; i + 4 <= len; i += 4) {
+		const float *x0 = &_x[2 * index[i + 0]];
+		const float *x1 = &_x[2 * index[i + 1]];
+		const float *x2 = &_x[2 * index[i + 2]];
+		const float *x3 = &_x[2 * index[i + 3]];
+		const float *h0 = &h[2 * h_len * path[i + 0]];
+		const float *h1 = &h[2 * h_len * path[i + 1]];
+		const float *h2 = &h[2 * h_len * path[i + 2]];
+		const float *h3 = &h[2 * h_len * path[i + 3]];
+
+		/* Zero */
+		a0 = a1 = a2 = a3 = _mm256_setzero_ps();
+
+		for (int n = 0; n < 2 * h_len; n += 8) {
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x0[n]),
+					     avx_load_real_taps(&h0[n]), a0);
+			a1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x1[n]),
+					     avx_load_real_taps(&h1[n]), a1);
+			a2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x2[n]),
+					     avx_load_real_taps(&h2[n]), a2);
+			a3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x3[n]),
+					     avx_load_real_taps(&h3[n]), a3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i], avx_hsum_cmplx4(a0, a1, a2, a3));
+	}
+
+	for (; i < len; i++) {
+		const float *x0 = &_x[2 * index[i]];
+		const float *h0 = &h[2 * h_len * path[i]];
+
+		a0 = _mm256_setzero_ps();
+
+		for (int n = 0; n < 2 * h_len; n += 8) {
+			a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x0[n]),
+					     avx_load_real_taps(&h0[n]), a0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i], avx_hsum_cmplx(a0));
+	}
+
+	return len;
+}
+
+/* Complex-complex multiply-accumulate of four input and tap samples */
+static inline void avx_cmac(__m256 x, __m256 h, __m256 *re, __m256 *im)
+{
+	/* (xr * hr, xi * hr) and (xr * hi, xi * hi) */
+	*re = _mm256_fmadd_ps(x, _mm256_moveldup_ps(h), *re);
+	*im = _mm256_fmadd_ps(x, _mm256_movehdup_ps(h), *im);
+}
+
+/* Combine the partial products of avx_cmac() into complex values */
+static inline __m256 avx_cmac_finish(__m256 re, __m256 im)
+{
+	/* Swap to (xi * hi, xr * hi) and combine real and imaginary */
+	im = _mm256_permute_ps(im, _MM_SHUFFLE(2, 3, 0, 1));
+
+	return _mm256_addsub_ps(re, im);
+}
+
+/* 4*N-tap AVX2 complex-complex convolution */
+int avx_conv_cmplx_4n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_complex() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_complex(), which are: x_len, y_len. */
+
+	__m256 m0, r0, r1, r2, r3, i0, i1, i2, i3;
+	int i = 0;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (; i + 4 <= len; i += 4) {
+		/* Zero */
+		r0 = r1 = r2 = r3 = _mm256_setzero_ps();
+		i0 = i1 = i2 = i3 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 4; n++) {
+			const float *_xn = &_x[2 * i + 8 * n];
+
+			/* Load (unaligned) filter taps */
+			m0 = _mm256_loadu_ps(&h[8 * n]);
+
+			avx_cmac(_mm256_loadu_ps(&_xn[0]), m0, &r0, &i0);
+			avx_cmac(_mm256_loadu_ps(&_xn[2]), m0, &r1, &i1);
+			avx_cmac(_mm256_loadu_ps(&_xn[4]), m0, &r2, &i2);
+			avx_cmac(_mm256_loadu_ps(&_xn[6]), m0, &r3, &i3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i],
+				 avx_hsum_cmplx4(avx_cmac_finish(r0, i0),
+						 avx_cmac_finish(r1, i1),
+						 avx_cmac_finish(r2, i2),
+						 avx_cmac_finish(r3, i3)));
+	}
+
+	for (; i < len; i++) {
+		r0 = i0 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 4; n++) {
+			avx_cmac(_mm256_loadu_ps(&_x[2 * i + 8 * n]),
+				 _mm256_loadu_ps(&h[8 * n]), &r0, &i0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i],
+			      avx_hsum_cmplx(avx_cmac_finish(r0, i0)));
+	}
+
+	return len;
+}
+
+/* 8*N-tap AVX2 complex-complex convolution */
+int avx_conv_cmplx_8n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len)
+{
+	/* See NOTE in avx_conv_cmplx_4n() */
+
+	__m256 m0, m1, r0, r1, r2, r3, i0, i1, i2, i3;
+	int i = 0;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	/* Two outputs per iteration with two accumulator pairs each */
+	for (; i + 2 <= len; i += 2) {
+		/* Zero */
+		r0 = r1 = r2 = r3 = _mm256_setzero_ps();
+		i0 = i1 = i2 = i3 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 8; n++) {
+			const float *_xn = &_x[2 * i + 16 * n];
+
+			/* Load (unaligned) filter taps */
+			m0 = _mm256_loadu_ps(&h[16 * n + 0]);
+			m1 = _mm256_loadu_ps(&h[16 * n + 8]);
+
+			avx_cmac(_mm256_loadu_ps(&_xn[0]), m0, &r0, &i0);
+			avx_cmac(_mm256_loadu_ps(&_xn[8]), m1, &r1, &i1);
+			avx_cmac(_mm256_loadu_ps(&_xn[2]), m0, &r2, &i2);
+			avx_cmac(_mm256_loadu_ps(&_xn[10]), m1, &r3, &i3);
+		}
+
+		r0 = avx_cmac_finish(_mm256_add_ps(r0, r1), _mm256_add_ps(i0, i1));
+		r2 = avx_cmac_finish(_mm256_add_ps(r2, r3), _mm256_add_ps(i2, i3));
+
+		_mm_storel_pi((__m64 *) &y[2 * i + 0], avx_hsum_cmplx(r0));
+		_mm_storel_pi((__m64 *) &y[2 * i + 2], avx_hsum_cmplx(r2));
+	}
+
+	for (; i < len; i++) {
+		r0 = r1 = i0 = i1 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len / 8; n++) {
+			const float *_xn = &_x[2 * i + 16 * n];
+
+			avx_cmac(_mm256_loadu_ps(&_xn[0]),
+				 _mm256_loadu_ps(&h[16 * n + 0]), &r0, &i0);
+			avx_cmac(_mm256_loadu_ps(&_xn[8]),
+				 _mm256_loadu_ps(&h[16 * n + 8]), &r1, &i1);
+		}
+
+		r0 = avx_cmac_finish(_mm256_add_ps(r0, r1), _mm256_add_ps(i0, i1));
+		_mm_storel_pi((__m64 *) &y[2 * i], avx_hsum_cmplx(r0));
+	}
+
+	return len;
+}
+
+/* N-tap AVX2 planar complex-complex convolution */
+int avx_conv_cmplx_planar(const float *x_re, const float *x_im, int x_len,
+			  const float *h_re, const float *h_im, int h_len,
+			  float *y_re, float *y_im, int y_len,
+			  int start, int len)
+{
+	/* See sse_conv_cmplx_planar() */
+
+	__m256 m0, m1, m2, m3, m4, m5;
+	__m256 rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1;
+	int i;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (i = 0; i < len; i += 16) {
+		/* Overlap the previous outputs if less than a block remains */
+		if (i + 16 > len) {
+			if (len < 16)
+				break;
+			i = len - 16;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = _mm256_setzero_ps();
+		rr1 = ii1 = ri1 = ir1 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = _mm256_broadcast_ss(&h_re[n]);
+			m5 = _mm256_broadcast_ss(&h_im[n]);
+			m0 = _mm256_loadu_ps(&_xr[i + n + 0]);
+			m1 = _mm256_loadu_ps(&_xi[i + n + 0]);
+			m2 = _mm256_loadu_ps(&_xr[i + n + 8]);
+			m3 = _mm256_loadu_ps(&_xi[i + n + 8]);
+
+			rr0 = _mm256_fmadd_ps(m0, m4, rr0);
+			ii0 = _mm256_fmadd_ps(m1, m5, ii0);
+			ri0 = _mm256_fmadd_ps(m0, m5, ri0);
+			ir0 = _mm256_fmadd_ps(m1, m4, ir0);
+			rr1 = _mm256_fmadd_ps(m2, m4, rr1);
+			ii1 = _mm256_fmadd_ps(m3, m5, ii1);
+			ri1 = _mm256_fmadd_ps(m2, m5, ri1);
+			ir1 = _mm256_fmadd_ps(m3, m4, ir1);
+		}
+
+		_mm256_storeu_ps(&y_re[i + 0], _mm256_sub_ps(rr0, ii0));
+		_mm256_storeu_ps(&y_re[i + 8], _mm256_sub_ps(rr1, ii1));
+		_mm256_storeu_ps(&y_im[i + 0], _mm256_add_ps(ri0, ir0));
+		_mm256_storeu_ps(&y_im[i + 8], _mm256_add_ps(ri1, ir1));
+	}
+
+	for (; i < len; i += 8) {
+		if (i + 8 > len) {
+			if (len < 8)
+				break;
+			i = len - 8;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = _mm256_setzero_ps();
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = _mm256_broadcast_ss(&h_re[n]);
+			m5 = _mm256_broadcast_ss(&h_im[n]);
+			m0 = _mm256_loadu_ps(&_xr[i + n]);
+			m1 = _mm256_loadu_ps(&_xi[i + n]);
+
+			rr0 = _mm256_fmadd_ps(m0, m4, rr0);
+			ii0 = _mm256_fmadd_ps(m1, m5, ii0);
+			ri0 = _mm256_fmadd_ps(m0, m5, ri0);
+			ir0 = _mm256_fmadd_ps(m1, m4, ir0);
+		}
+
+		_mm256_storeu_ps(&y_re[i], _mm256_sub_ps(rr0, ii0));
+		_mm256_storeu_ps(&y_im[i], _mm256_add_ps(ri0, ir0));
+	}
+
+	for (; i < len; i++) {
+		float sum_re = 0.0f, sum_im = 0.0f;
+
+		for (int n = 0; n < h_len; n++) {
+			sum_re += _xr[i + n] * h_re[n] - _xi[i + n] * h_im[n];
+			sum_im += _xr[i + n] * h_im[n] + _xi[i + n] * h_re[n];
+		}
+
+		y_re[i] = sum_re;
+		y_im[i] = sum_im;
+	}
+
+	return len;
+}
+
+/*
+ * N-tap AVX2 planar complex-complex convolution against multiple sequences
+ *
+ * Sequences are taken three at a time so that each input load feeds the
+ * multiply-accumulates of all three, twelve accumulators in total. One or
+ * two remaining sequences go through the single sequence kernel.
+ */
+int avx_conv_cmplx_planar_multi(const float *x_re, const float *x_im,
+				int x_len,
+				const float *h_re, const float *h_im,
+				int h_len, int h_num,
+				float *y_re, float *y_im, int y_len,
+				int start, int len)
+{
+	__m256 m0, m1, m2, m3;
+	__m256 rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1, rr2, ii2, ri2, ir2;
+	int i, k;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (k = 0; k + 3 <= h_num && len >= 8; k += 3) {
+		const float *hr = &h_re[k * h_len];
+		const float *hi = &h_im[k * h_len];
+		float *yr = &y_re[k * y_len];
+		float *yi = &y_im[k * y_len];
+
+		for (i = 0; i < len; i += 8) {
+			if (i + 8 > len)
+				i = len - 8;
+
+			rr0 = ii0 = ri0 = ir0 = _mm256_setzero_ps();
+			rr1 = ii1 = ri1 = ir1 = _mm256_setzero_ps();
+			rr2 = ii2 = ri2 = ir2 = _mm256_setzero_ps();
+
+			for (int n = 0; n < h_len; n++) {
+				m0 = _mm256_loadu_ps(&_xr[i + n]);
+				m1 = _mm256_loadu_ps(&_xi[i + n]);
+
+				m2 = _mm256_broadcast_ss(&hr[n]);
+				m3 = _mm256_broadcast_ss(&hi[n]);
+				rr0 = _mm256_fmadd_ps(m0, m2, rr0);
+				ii0 = _mm256_fmadd_ps(m1, m3, ii0);
+				ri0 = _mm256_fmadd_ps(m0, m3, ri0);
+				ir0 = _mm256_fmadd_ps(m1, m2, ir0);
+
+				m2 = _mm256_broadcast_ss(&hr[n + h_len]);
+				m3 = _mm256_broadcast_ss(&hi[n + h_len]);
+				rr1 = _mm256_fmadd_ps(m0, m2, rr1);
+				ii1 = _mm256_fmadd_ps(m1, m3, ii1);
+				ri1 = _mm256_fmadd_ps(m0, m3, ri1);
+				ir1 = _mm256_fmadd_ps(m1, m2, ir1);
+
+				m2 = _mm256_broadcast_ss(&hr[n + 2 * h_len]);
+				m3 = _mm256_broadcast_ss(&hi[n + 2 * h_len]);
+				rr2 = _mm256_fmadd_ps(m0, m2, rr2);
+				ii2 = _mm256_fmadd_ps(m1, m3, ii2);
+				ri2 = _mm256_fmadd_ps(m0, m3, ri2);
+				ir2 = _mm256_fmadd_ps(m1, m2, ir2);
+			}
+
+			_mm256_storeu_ps(&yr[i], _mm256_sub_ps(rr0, ii0));
+			_mm256_storeu_ps(&yi[i], _mm256_add_ps(ri0, ir0));
+			_mm256_storeu_ps(&yr[i + y_len], _mm256_sub_ps(rr1, ii1));
+			_mm256_storeu_ps(&yi[i + y_len], _mm256_add_ps(ri1, ir1));
+			_mm256_storeu_ps(&yr[i + 2 * y_len],
+					 _mm256_sub_ps(rr2, ii2));
+			_mm256_storeu_ps(&yi[i + 2 * y_len],
+					 _mm256_add_ps(ri2, ir2));
+		}
+	}
+
+	for (; k < h_num; k++) {
+		avx_conv_cmplx_planar(x_re, x_im, x_len,
+				      &h_re[k * h_len], &h_im[k * h_len], h_len,
+				      &y_re[k * y_len], &y_im[k * y_len], y_len,
+				      start, len);
+	}
+
+	return len;
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * AVX2 Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+/* 4-tap AVX2 complex-real convolution */
+int avx_conv_real4(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len);
+
+/* 8-tap AVX2 complex-real convolution */
+int avx_conv_real8(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len);
+
+/* 12-tap AVX2 complex-real convolution */
+int avx_conv_real12(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
+
+/* 16-tap AVX2 complex-real convolution */
+int avx_conv_real16(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
+
+/* 20-tap AVX2 complex-real convolution */
+int avx_conv_real20(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
+
+/* 4*N-tap AVX2 complex-real convolution */
+int avx_conv_real4n(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
+
+/* 4*N-tap AVX2 polyphase complex-real convolution */
+int avx_conv_real4n_polyphase(const float *x, int x_len,
+			      const float *h, int h_len,
+			      float *y, int y_len,
+			      const int *index, const int *path, int len);
+
+/* 4*N-tap AVX2 complex-complex convolution */
+int avx_conv_cmplx_4n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len);
+
+/* 8*N-tap AVX2 complex-complex convolution */
+int avx_conv_cmplx_8n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len);
+
+/* N-tap AVX2 planar complex-complex convolution */
+int avx_conv_cmplx_planar(const float *x_re, const float *x_im, int x_len,
+			  const float *h_re, const float *h_im, int h_len,
+			  float *y_re, float *y_im, int y_len,
+			  int start, int len);
+
+/* N-tap AVX2 planar complex-complex convolution, multiple sequences */
+int avx_conv_cmplx_planar_multi(const float *x_re, const float *x_im,
+				int x_len,
+				const float *h_re, const float *h_im,
+				int h_len, int h_num,
+				float *y_re, float *y_im, int y_len,
+				int start, int len);
@@ -0,0 +1,315 @@
+/*
+ * AVX-512 Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include "convolve_avx512.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX512
+#include <immintrin.h>
+
+/*
+ * Same interleaved I/Q scheme as the AVX2 kernels, but with eight complex
+ * samples per 512-bit register. Filter lengths that are not a multiple of
+ * eight are handled with a masked load of the last partial block, so every
+ * h_len is served by these kernels without a scalar fallback.
+ */
+
+/* Mask covering the I and Q lanes of the trailing h_len % 8 taps */
+static inline __mmask16 avx512_tail_mask(int h_len)
+{
+	return (__mmask16) ((1 << (2 * (h_len % 8))) - 1);
+}
+
+/* Reduce a 512-bit accumulator to its two 256-bit halves */
+static inline __m256 avx512_fold(__m512 m)
+{
+	__m256 hi;
+
+	hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(m), 1));
+
+	return _mm256_add_ps(_mm512_castps512_ps256(m), hi);
+}
+
+/* Horizontal sum of four complex values into the lower half of an SSE reg */
+static inline __m128 avx512_hsum_cmplx(__m512 m)
+{
+	__m256 m0 = avx512_fold(m);
+	__m128 m1, m2;
+
+	m1 = _mm_add_ps(_mm256_castps256_ps128(m0),
+			_mm256_extractf128_ps(m0, 1));
+	m2 = _mm_movehl_ps(m1, m1);
+
+	return _mm_add_ps(m1, m2);
+}
+
+/* Horizontal sums of four accumulators into four consecutive outputs */
+static inline __m256 avx512_hsum_cmplx4(__m512 a0, __m512 a1,
+					__m512 a2, __m512 a3)
+{
+	__m256 b0, b1, b2, b3, m0, m1;
+
+	b0 = avx512_fold(a0);
+	b1 = avx512_fold(a1);
+	b2 = avx512_fold(a2);
+	b3 = avx512_fold(a3);
+
+	m0 = _mm256_add_ps(_mm256_permute2f128_ps(b0, b2, 0x20),
+			   _mm256_permute2f128_ps(b0, b2, 0x31));
+	m1 = _mm256_add_ps(_mm256_permute2f128_ps(b1, b3, 0x20),
+			   _mm256_permute2f128_ps(b1, b3, 0x31));
+
+	return _mm256_add_ps(_mm256_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 1, 0)),
+			     _mm256_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+/* Complex-complex multiply-accumulate of eight input and tap samples */
+static inline void avx512_cmac(__m512 x, __m512 h, __m512 *re, __m512 *im)
+{
+	/* (xr * hr, xi * hr) and (xr * hi, xi * hi) */
+	*re = _mm512_fmadd_ps(x, _mm512_moveldup_ps(h), *re);
+	*im = _mm512_fmadd_ps(x, _mm512_movehdup_ps(h), *im);
+}
+
+/* Combine the partial products of avx512_cmac() into complex values */
+static inline __m512 avx512_cmac_finish(__m512 re, __m512 im)
+{
+	/* Swap to (xi * hi, xr * hi) and combine real and imaginary */
+	im = _mm512_permute_ps(im, _MM_SHUFFLE(2, 3, 0, 1));
+
+	return _mm512_fmaddsub_ps(_mm512_set1_ps(1.0f), re, im);
+}
+
+/* N-tap AVX-512 complex-real convolution */
+int avx512_conv_real(const float *x, int x_len,
+		     const float *h, int h_len,
+		     float *y, int y_len,
+		     int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_real() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_real(), which are: x_len, y_len. */
+
+	__m512 m0, a0, a1, a2, a3;
+	__mmask16 k = avx512_tail_mask(h_len);
+	int blks = h_len / 8;
+	int i = 0;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (; i + 4 <= len; i += 4) {
+		/* Zero */
+		a0 = a1 = a2 = a3 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n++) {
+			const float *_xn = &_x[2 * i + 16 * n];
+
+			m0 = _mm512_moveldup_ps(_mm512_loadu_ps(&h[16 * n]));
+			a0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_xn[0]), m0, a0);
+			a1 = _mm512_fmadd_ps(_mm512_loadu_ps(&_xn[2]), m0, a1);
+			a2 = _mm512_fmadd_ps(_mm512_loadu_ps(&_xn[4]), m0, a2);
+			a3 = _mm512_fmadd_ps(_mm512_loadu_ps(&_xn[6]), m0, a3);
+		}
+
+		if (k) {
+			const float *_xn = &_x[2 * i + 16 * blks];
+
+			m0 = _mm512_maskz_loadu_ps(k, &h[16 * blks]);
+			m0 = _mm512_moveldup_ps(m0);
+			a0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, &_xn[0]), m0, a0);
+			a1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, &_xn[2]), m0, a1);
+			a2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, &_xn[4]), m0, a2);
+			a3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, &_xn[6]), m0, a3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i], avx512_hsum_cmplx4(a0, a1, a2, a3));
+	}
+
+	for (; i < len; i++) {
+		a0 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n++) {
+			m0 = _mm512_moveldup_ps(_mm512_loadu_ps(&h[16 * n]));
+			a0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[2 * i + 16 * n]),
+					     m0, a0);
+		}
+
+		if (k) {
+			m0 = _mm512_maskz_loadu_ps(k, &h[16 * blks]);
+			m0 = _mm512_moveldup_ps(m0);
+			a0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k,
+					     &_x[2 * i + 16 * blks]), m0, a0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i], avx512_hsum_cmplx(a0));
+	}
+
+	return len;
+}
+
+/* Masked multiply-accumulate of eight input samples with real taps */
+static inline __m512 avx512_mac_real(const float *x, const float *h,
+				     __mmask16 k, __m512 a)
+{
+	__m512 m0 = _mm512_moveldup_ps(_mm512_maskz_loadu_ps(k, h));
+
+	return _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, x), m0, a);
+}
+
+/* N-tap AVX-512 polyphase complex-real convolution */
+int avx512_conv_real_polyphase(const float *x, int x_len,
+			       const float *h, int h_len,
+			       float *y, int y_len,
+			       const int *index, const int *path, int len)
+{
+	/* See NOTE in avx512_conv_real() */
+
+	__m512 a0, a1, a2, a3;
+	__mmask16 k = avx512_tail_mask(h_len);
+	int blks = 16 * (h_len / 8);
+	int i = 0;
+
+	const float *_x = &x[2 * -(h_len - 1)];
+
+	/* Four outputs, each with its own input offset and filter partition */
+	for (; i + 4 <= len; i += 4) {
+		const float *x0 = &_x[2 * index[i + 0]];
+		const float *x1 = &_x[2 * index[i + 1]];
+		const float *x2 = &_x[2 * index[i + 2]];
+		const float *x3 = &_x[2 * index[i + 3]];
+		const float *h0 = &h[2 * h_len * path[i + 0]];
+		const float *h1 = &h[2 * h_len * path[i + 1]];
+		const float *h2 = &h[2 * h_len * path[i + 2]];
+		const float *h3 = &h[2 * h_len * path[i + 3]];
+
+		/* Zero */
+		a0 = a1 = a2 = a3 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n += 16) {
+			a0 = avx512_mac_real(&x0[n], &h0[n], 0xffff, a0);
+			a1 = avx512_mac_real(&x1[n], &h1[n], 0xffff, a1);
+			a2 = avx512_mac_real(&x2[n], &h2[n], 0xffff, a2);
+			a3 = avx512_mac_real(&x3[n], &h3[n], 0xffff, a3);
+		}
+
+		if (k) {
+			a0 = avx512_mac_real(&x0[blks], &h0[blks], k, a0);
+			a1 = avx512_mac_real(&x1[blks], &h1[blks], k, a1);
+			a2 = avx512_mac_real(&x2[blks], &h2[blks], k, a2);
+			a3 = avx512_mac_real(&x3[blks], &h3[blks], k, a3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i], avx512_hsum_cmplx4(a0, a1, a2, a3));
+	}
+
+	for (; i < len; i++) {
+		const float *x0 = &_x[2 * index[i]];
+		const float *h0 = &h[2 * h_len * path[i]];
+
+		a0 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n += 16)
+			a0 = avx512_mac_real(&x0[n], &h0[n], 0xffff, a0);
+
+		if (k)
+			a0 = avx512_mac_real(&x0[blks], &h0[blks], k, a0);
+
+		_mm_storel_pi((__m64 *) &y[2 * i], avx512_hsum_cmplx(a0));
+	}
+
+	return len;
+}
+
+/* N-tap AVX-512 complex-complex convolution */
+int avx512_conv_cmplx(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len)
+{
+	/* NOTE: The parameter list of this function has to match the parameter
+	 * list of _base_convolve_complex() in convolve_base.c. This specific
+	 * implementation, ignores some of the parameters of
+	 * _base_convolve_complex(), which are: x_len, y_len. */
+
+	__m512 m0, r0, r1, r2, r3, i0, i1, i2, i3;
+	__mmask16 k = avx512_tail_mask(h_len);
+	int blks = h_len / 8;
+	int i = 0;
+
+	const float *_x = &x[2 * (-(h_len - 1) + start)];
+
+	for (; i + 4 <= len; i += 4) {
+		/* Zero */
+		r0 = r1 = r2 = r3 = _mm512_setzero_ps();
+		i0 = i1 = i2 = i3 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n++) {
+			const float *_xn = &_x[2 * i + 16 * n];
+
+			m0 = _mm512_loadu_ps(&h[16 * n]);
+			avx512_cmac(_mm512_loadu_ps(&_xn[0]), m0, &r0, &i0);
+			avx512_cmac(_mm512_loadu_ps(&_xn[2]), m0, &r1, &i1);
+			avx512_cmac(_mm512_loadu_ps(&_xn[4]), m0, &r2, &i2);
+			avx512_cmac(_mm512_loadu_ps(&_xn[6]), m0, &r3, &i3);
+		}
+
+		if (k) {
+			const float *_xn = &_x[2 * i + 16 * blks];
+
+			m0 = _mm512_maskz_loadu_ps(k, &h[16 * blks]);
+			avx512_cmac(_mm512_maskz_loadu_ps(k, &_xn[0]), m0, &r0, &i0);
+			avx512_cmac(_mm512_maskz_loadu_ps(k, &_xn[2]), m0, &r1, &i1);
+			avx512_cmac(_mm512_maskz_loadu_ps(k, &_xn[4]), m0, &r2, &i2);
+			avx512_cmac(_mm512_maskz_loadu_ps(k, &_xn[6]), m0, &r3, &i3);
+		}
+
+		_mm256_storeu_ps(&y[2 * i],
+				 avx512_hsum_cmplx4(avx512_cmac_finish(r0, i0),
+						    avx512_cmac_finish(r1, i1),
+						    avx512_cmac_finish(r2, i2),
+						    avx512_cmac_finish(r3, i3)));
+	}
+
+	for (; i < len; i++) {
+		r0 = i0 = _mm512_setzero_ps();
+
+		for (int n = 0; n < blks; n++) {
+			avx512_cmac(_mm512_loadu_ps(&_x[2 * i + 16 * n]),
+				    _mm512_loadu_ps(&h[16 * n]), &r0, &i0);
+		}
+
+		if (k) {
+			avx512_cmac(_mm512_maskz_loadu_ps(k, &_x[2 * i + 16 * blks]),
+				    _mm512_maskz_loadu_ps(k, &h[16 * blks]),
+				    &r0, &i0);
+		}
+
+		_mm_storel_pi((__m64 *) &y[2 * i],
+			      avx512_hsum_cmplx(avx512_cmac_finish(r0, i0)));
+	}
+
+	return len;
+}
+#endif
@@ -0,0 +1,37 @@
+/*
+ * AVX-512 Convolution
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+
+/* N-tap AVX-512 complex-real convolution */
+int avx512_conv_real(const float *x, int x_len,
+		     const float *h, int h_len,
+		     float *y, int y_len,
+		     int start, int len);
+
+/* N-tap AVX-512 polyphase complex-real convolution */
+int avx512_conv_real_polyphase(const float *x, int x_len,
+			       const float *h, int h_len,
+			       float *y, int y_len,
+			       const int *index, const int *path, int len);
+
+/* N-tap AVX-512 complex-complex convolution */
+int avx512_conv_cmplx(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len);
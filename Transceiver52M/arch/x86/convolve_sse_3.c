@@ -31,10 +31,10 @@
 #include <pmmintrin.h>
 
 /* 4-tap SSE complex-real convolution */
-void sse_conv_real4(const float *x, int x_len,
-		    const float *h, int h_len,
-		    float *y, int y_len,
-		    int start, int len)
+int sse_conv_real4(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len)
 {
 	/* NOTE: The parameter list of this function has to match the parameter
 	 * list of _base_convolve_real() in convolve_base.c. This specific
@@ -69,13 +69,15 @@ void sse_conv_real4(const float *x, int x_len,
 		m0 = _mm_shuffle_ps(m0, m0, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m0);
 	}
+
+	return len;
 }
 
 /* 8-tap SSE complex-real convolution */
-void sse_conv_real8(const float *x, int x_len,
-		    const float *h, int h_len,
-		    float *y, int y_len,
-		    int start, int len)
+int sse_conv_real8(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len)
 {
 	/* See NOTE in sse_conv_real4() */
 
@@ -120,13 +122,15 @@ void sse_conv_real8(const float *x, int x_len,
 		m6 = _mm_shuffle_ps(m6, m6, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m6);
 	}
+
+	return len;
 }
 
 /* 12-tap SSE complex-real convolution */
-void sse_conv_real12(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len)
+int sse_conv_real12(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
 {
 	/* See NOTE in sse_conv_real4() */
 
@@ -186,13 +190,15 @@ void sse_conv_real12(const float *x, int x_len,
 		m3 = _mm_shuffle_ps(m3, m3, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m3);
 	}
+
+	return len;
 }
 
 /* 16-tap SSE complex-real convolution */
-void sse_conv_real16(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len)
+int sse_conv_real16(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
 {
 	/* See NOTE in sse_conv_real4() */
 
@@ -265,13 +271,15 @@ void sse_conv_real16(const float *x, int x_len,
 		m3 = _mm_shuffle_ps(m3, m3, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m3);
 	}
+
+	return len;
 }
 
 /* 20-tap SSE complex-real convolution */
-void sse_conv_real20(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len)
+int sse_conv_real20(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
 {
 	/* See NOTE in sse_conv_real4() */
 
@@ -355,13 +363,15 @@ void sse_conv_real20(const float *x, int x_len,
 		m3 = _mm_shuffle_ps(m3, m3, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m3);
 	}
+
+	return len;
 }
 
 /* 4*N-tap SSE complex-real convolution */
-void sse_conv_real4n(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len)
+int sse_conv_real4n(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len)
 {
 	/* See NOTE in sse_conv_real4() */
 
@@ -402,13 +412,65 @@ void sse_conv_real4n(const float *x, int x_len,
 		m0 = _mm_shuffle_ps(m0, m0, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m0);
 	}
+
+	return len;
+}
+
+/* 4*N-tap SSE polyphase complex-real convolution */
+int sse_conv_real4n_polyphase(const float *x, int x_len,
+			      const float *h, int h_len,
+			      float *y, int y_len,
+			      const int *index, const int *path, int len)
+{
+	/* See NOTE in sse_conv_real4() */
+
+	__m128 m0, m1, m2, m4, m5, m6, m7;
+
+	for (int i = 0; i < len; i++) {
+		const float *_x = &x[2 * (-(h_len - 1) + index[i])];
+		const float *_h = &h[2 * h_len * path[i]];
+
+		/* Zero */
+		m6 = _mm_setzero_ps();
+		m7 = _mm_setzero_ps();
+
+		for (int n = 0; n < h_len / 4; n++) {
+			/* Load (aligned) filter taps */
+			m0 = _mm_load_ps(&_h[8 * n + 0]);
+			m1 = _mm_load_ps(&_h[8 * n + 4]);
+			m2 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 2, 0, 2));
+
+			/* Load (unaligned) input data */
+			m0 = _mm_loadu_ps(&_x[8 * n + 0]);
+			m1 = _mm_loadu_ps(&_x[8 * n + 4]);
+			m4 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 2, 0, 2));
+			m5 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 3, 1, 3));
+
+			/* Quad multiply */
+			m0 = _mm_mul_ps(m2, m4);
+			m1 = _mm_mul_ps(m2, m5);
+
+			/* Accumulate */
+			m6 = _mm_add_ps(m6, m0);
+			m7 = _mm_add_ps(m7, m1);
+		}
+
+		m0 = _mm_hadd_ps(m6, m7);
+		m0 = _mm_hadd_ps(m0, m0);
+
+		_mm_store_ss(&y[2 * i + 0], m0);
+		m0 = _mm_shuffle_ps(m0, m0, _MM_SHUFFLE(0, 3, 2, 1));
+		_mm_store_ss(&y[2 * i + 1], m0);
+	}
+
+	return len;
 }
 
 /* 4*N-tap SSE complex-complex convolution */
-void sse_conv_cmplx_4n(const float *x, int x_len,
-		       const float *h, int h_len,
-		       float *y, int y_len,
-		       int start, int len)
+int sse_conv_cmplx_4n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len)
 {
 	/* NOTE: The parameter list of this function has to match the parameter
 	 * list of _base_convolve_complex() in convolve_base.c. This specific
@@ -460,13 +522,15 @@ void sse_conv_cmplx_4n(const float *x, int x_len,
 		m0 = _mm_shuffle_ps(m0, m0, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m0);
 	}
+
+	return len;
 }
 
 /* 8*N-tap SSE complex-complex convolution */
-void sse_conv_cmplx_8n(const float *x, int x_len,
-		       const float *h, int h_len,
-		       float *y, int y_len,
-		       int start, int len)
+int sse_conv_cmplx_8n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len)
 {
 	/* See NOTE in sse_conv_cmplx_4n() */
 
@@ -538,5 +602,181 @@ void sse_conv_cmplx_8n(const float *x, int x_len,
 		m2 = _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(0, 3, 2, 1));
 		_mm_store_ss(&y[2 * i + 1], m2);
 	}
+
+	return len;
+}
+
+/*
+ * N-tap SSE planar complex-complex convolution
+ *
+ * Consecutive outputs share a register and each tap is broadcast into all of
+ * them, so no lane shuffles or horizontal sums are needed. The four partial
+ * products of the complex multiply go to separate accumulators to keep the
+ * dependency chains short. Outputs are stored rather than accumulated, which
+ * lets a trailing partial vector be handled by recomputing the last full
+ * vector of outputs.
+ */
+int sse_conv_cmplx_planar(const float *x_re, const float *x_im, int x_len,
+			  const float *h_re, const float *h_im, int h_len,
+			  float *y_re, float *y_im, int y_len,
+			  int start, int len)
+{
+	__m128 m0, m1, m2, m3, m4, m5;
+	__m128 rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1;
+	int i;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (i = 0; i < len; i += 8) {
+		/* Overlap the previous outputs if less than a block remains */
+		if (i + 8 > len) {
+			if (len < 8)
+				break;
+			i = len - 8;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = _mm_setzero_ps();
+		rr1 = ii1 = ri1 = ir1 = _mm_setzero_ps();
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = _mm_set1_ps(h_re[n]);
+			m5 = _mm_set1_ps(h_im[n]);
+			m0 = _mm_loadu_ps(&_xr[i + n + 0]);
+			m1 = _mm_loadu_ps(&_xi[i + n + 0]);
+			m2 = _mm_loadu_ps(&_xr[i + n + 4]);
+			m3 = _mm_loadu_ps(&_xi[i + n + 4]);
+
+			rr0 = _mm_add_ps(rr0, _mm_mul_ps(m0, m4));
+			ii0 = _mm_add_ps(ii0, _mm_mul_ps(m1, m5));
+			ri0 = _mm_add_ps(ri0, _mm_mul_ps(m0, m5));
+			ir0 = _mm_add_ps(ir0, _mm_mul_ps(m1, m4));
+			rr1 = _mm_add_ps(rr1, _mm_mul_ps(m2, m4));
+			ii1 = _mm_add_ps(ii1, _mm_mul_ps(m3, m5));
+			ri1 = _mm_add_ps(ri1, _mm_mul_ps(m2, m5));
+			ir1 = _mm_add_ps(ir1, _mm_mul_ps(m3, m4));
+		}
+
+		_mm_storeu_ps(&y_re[i + 0], _mm_sub_ps(rr0, ii0));
+		_mm_storeu_ps(&y_re[i + 4], _mm_sub_ps(rr1, ii1));
+		_mm_storeu_ps(&y_im[i + 0], _mm_add_ps(ri0, ir0));
+		_mm_storeu_ps(&y_im[i + 4], _mm_add_ps(ri1, ir1));
+	}
+
+	for (; i < len; i += 4) {
+		if (i + 4 > len) {
+			if (len < 4)
+				break;
+			i = len - 4;
+		}
+
+		rr0 = ii0 = ri0 = ir0 = _mm_setzero_ps();
+
+		for (int n = 0; n < h_len; n++) {
+			m4 = _mm_set1_ps(h_re[n]);
+			m5 = _mm_set1_ps(h_im[n]);
+			m0 = _mm_loadu_ps(&_xr[i + n]);
+			m1 = _mm_loadu_ps(&_xi[i + n]);
+
+			rr0 = _mm_add_ps(rr0, _mm_mul_ps(m0, m4));
+			ii0 = _mm_add_ps(ii0, _mm_mul_ps(m1, m5));
+			ri0 = _mm_add_ps(ri0, _mm_mul_ps(m0, m5));
+			ir0 = _mm_add_ps(ir0, _mm_mul_ps(m1, m4));
+		}
+
+		_mm_storeu_ps(&y_re[i], _mm_sub_ps(rr0, ii0));
+		_mm_storeu_ps(&y_im[i], _mm_add_ps(ri0, ir0));
+	}
+
+	for (; i < len; i++) {
+		float sum_re = 0.0f, sum_im = 0.0f;
+
+		for (int n = 0; n < h_len; n++) {
+			sum_re += _xr[i + n] * h_re[n] - _xi[i + n] * h_im[n];
+			sum_im += _xr[i + n] * h_im[n] + _xi[i + n] * h_re[n];
+		}
+
+		y_re[i] = sum_re;
+		y_im[i] = sum_im;
+	}
+
+	return len;
+}
+
+/*
+ * N-tap SSE planar complex-complex convolution against multiple sequences,
+ * three at a time with shared input loads, see avx_conv_cmplx_planar_multi()
+ */
+int sse_conv_cmplx_planar_multi(const float *x_re, const float *x_im,
+				int x_len,
+				const float *h_re, const float *h_im,
+				int h_len, int h_num,
+				float *y_re, float *y_im, int y_len,
+				int start, int len)
+{
+	__m128 m0, m1, m2, m3;
+	__m128 rr0, ii0, ri0, ir0, rr1, ii1, ri1, ir1, rr2, ii2, ri2, ir2;
+	int i, k;
+
+	const float *_xr = &x_re[-(h_len - 1) + start];
+	const float *_xi = &x_im[-(h_len - 1) + start];
+
+	for (k = 0; k + 3 <= h_num && len >= 4; k += 3) {
+		const float *hr = &h_re[k * h_len];
+		const float *hi = &h_im[k * h_len];
+		float *yr = &y_re[k * y_len];
+		float *yi = &y_im[k * y_len];
+
+		for (i = 0; i < len; i += 4) {
+			if (i + 4 > len)
+				i = len - 4;
+
+			rr0 = ii0 = ri0 = ir0 = _mm_setzero_ps();
+			rr1 = ii1 = ri1 = ir1 = _mm_setzero_ps();
+			rr2 = ii2 = ri2 = ir2 = _mm_setzero_ps();
+
+			for (int n = 0; n < h_len; n++) {
+				m0 = _mm_loadu_ps(&_xr[i + n]);
+				m1 = _mm_loadu_ps(&_xi[i + n]);
+
+				m2 = _mm_set1_ps(hr[n]);
+				m3 = _mm_set1_ps(hi[n]);
+				rr0 = _mm_add_ps(rr0, _mm_mul_ps(m0, m2));
+				ii0 = _mm_add_ps(ii0, _mm_mul_ps(m1, m3));
+				ri0 = _mm_add_ps(ri0, _mm_mul_ps(m0, m3));
+				ir0 = _mm_add_ps(ir0, _mm_mul_ps(m1, m2));
+
+				m2 = _mm_set1_ps(hr[n + h_len]);
+				m3 = _mm_set1_ps(hi[n + h_len]);
+				rr1 = _mm_add_ps(rr1, _mm_mul_ps(m0, m2));
+				ii1 = _mm_add_ps(ii1, _mm_mul_ps(m1, m3));
+				ri1 = _mm_add_ps(ri1, _mm_mul_ps(m0, m3));
+				ir1 = _mm_add_ps(ir1, _mm_mul_ps(m1, m2));
+
+				m2 = _mm_set1_ps(hr[n + 2 * h_len]);
+				m3 = _mm_set1_ps(hi[n + 2 * h_len]);
+				rr2 = _mm_add_ps(rr2, _mm_mul_ps(m0, m2));
+				ii2 = _mm_add_ps(ii2, _mm_mul_ps(m1, m3));
+				ri2 = _mm_add_ps(ri2, _mm_mul_ps(m0, m3));
+				ir2 = _mm_add_ps(ir2, _mm_mul_ps(m1, m2));
+			}
+
+			_mm_storeu_ps(&yr[i], _mm_sub_ps(rr0, ii0));
+			_mm_storeu_ps(&yi[i], _mm_add_ps(ri0, ir0));
+			_mm_storeu_ps(&yr[i + y_len], _mm_sub_ps(rr1, ii1));
+			_mm_storeu_ps(&yi[i + y_len], _mm_add_ps(ri1, ir1));
+			_mm_storeu_ps(&yr[i + 2 * y_len], _mm_sub_ps(rr2, ii2));
+			_mm_storeu_ps(&yi[i + 2 * y_len], _mm_add_ps(ri2, ir2));
+		}
+	}
+
+	for (; k < h_num; k++) {
+		sse_conv_cmplx_planar(x_re, x_im, x_len,
+				      &h_re[k * h_len], &h_im[k * h_len], h_len,
+				      &y_re[k * y_len], &y_im[k * y_len], y_len,
+				      start, len);
+	}
+
+	return len;
 }
 #endif
@@ -20,49 +20,69 @@
 #pragma once
 
 /* 4-tap SSE complex-real convolution */
-void sse_conv_real4(const float *x, int x_len,
-		    const float *h, int h_len,
-		    float *y, int y_len,
-		    int start, int len);
+int sse_conv_real4(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len);
 
 /* 8-tap SSE complex-real convolution */
-void sse_conv_real8(const float *x, int x_len,
+int sse_conv_real8(const float *x, int x_len,
+		   const float *h, int h_len,
+		   float *y, int y_len,
+		   int start, int len);
+
+/* 12-tap SSE complex-real convolution */
+int sse_conv_real12(const float *x, int x_len,
 		    const float *h, int h_len,
 		    float *y, int y_len,
 		    int start, int len);
 
-/* 12-tap SSE complex-real convolution */
-void sse_conv_real12(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len);
-
 /* 16-tap SSE complex-real convolution */
-void sse_conv_real16(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len);
+int sse_conv_real16(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
 
 /* 20-tap SSE complex-real convolution */
-void sse_conv_real20(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len);
+int sse_conv_real20(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
 
 /* 4*N-tap SSE complex-real convolution */
-void sse_conv_real4n(const float *x, int x_len,
-		     const float *h, int h_len,
-		     float *y, int y_len,
-		     int start, int len);
+int sse_conv_real4n(const float *x, int x_len,
+		    const float *h, int h_len,
+		    float *y, int y_len,
+		    int start, int len);
+
+/* 4*N-tap SSE polyphase complex-real convolution */
+int sse_conv_real4n_polyphase(const float *x, int x_len,
+			      const float *h, int h_len,
+			      float *y, int y_len,
+			      const int *index, const int *path, int len);
 
 /* 4*N-tap SSE complex-complex convolution */
-void sse_conv_cmplx_4n(const float *x, int x_len,
-		       const float *h, int h_len,
-		       float *y, int y_len,
-		       int start, int len);
+int sse_conv_cmplx_4n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len);
 
 /* 8*N-tap SSE complex-complex convolution */
-void sse_conv_cmplx_8n(const float *x, int x_len,
-		       const float *h, int h_len,
-		       float *y, int y_len,
-		       int start, int len);
+int sse_conv_cmplx_8n(const float *x, int x_len,
+		      const float *h, int h_len,
+		      float *y, int y_len,
+		      int start, int len);
+
+/* N-tap SSE planar complex-complex convolution */
+int sse_conv_cmplx_planar(const float *x_re, const float *x_im, int x_len,
+			  const float *h_re, const float *h_im, int h_len,
+			  float *y_re, float *y_im, int y_len,
+			  int start, int len);
+
+/* N-tap SSE planar complex-complex convolution, multiple sequences */
+int sse_conv_cmplx_planar_multi(const float *x_re, const float *x_im,
+				int x_len,
+				const float *h_re, const float *h_im,
+				int h_len, int h_num,
+				float *y_re, float *y_im, int y_len,
+				int start, int len);
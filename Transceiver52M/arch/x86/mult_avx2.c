@@ -0,0 +1,52 @@
+/*
+ * AVX2 complex multiplication
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mult.h"
+#include "mult_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+
+/* Element-wise complex multiplication with remainder */
+void avx_mul_complex(float *out, float *a, float *b, int len)
+{
+	__m256 m0, m1, m2;
+	int i;
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		/* Load (unaligned) four complex samples of each input */
+		m0 = _mm256_loadu_ps(&a[2 * i]);
+		m1 = _mm256_loadu_ps(&b[2 * i]);
+
+		/* (aq * bq, ai * bq) */
+		m2 = _mm256_permute_ps(m0, _MM_SHUFFLE(2, 3, 0, 1));
+		m2 = _mm256_mul_ps(m2, _mm256_movehdup_ps(m1));
+
+		/* (ai * bi - aq * bq, aq * bi + ai * bq) */
+		m0 = _mm256_fmaddsub_ps(m0, _mm256_moveldup_ps(m1), m2);
+		_mm256_storeu_ps(&out[2 * i], m0);
+	}
+
+	if (i < len)
+		base_mul_complex(&out[2 * i], &a[2 * i], &b[2 * i], len - i);
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * SSE complex multiplication
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mult.h"
+#include "mult_sse_3.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_SSE3
+#include <xmmintrin.h>
+#include <pmmintrin.h>
+
+/* Element-wise complex multiplication with remainder */
+void sse_mul_complex(float *out, float *a, float *b, int len)
+{
+	__m128 m0, m1, m2, m3;
+	int i;
+
+	for (i = 0; i + 2 <= len; i += 2) {
+		/* Load (unaligned) two complex samples of each input */
+		m0 = _mm_loadu_ps(&a[2 * i]);
+		m1 = _mm_loadu_ps(&b[2 * i]);
+
+		/* (ai * bi, aq * bi) */
+		m2 = _mm_mul_ps(m0, _mm_moveldup_ps(m1));
+
+		/* (aq * bq, ai * bq) */
+		m0 = _mm_shuffle_ps(m0, m0, _MM_SHUFFLE(2, 3, 0, 1));
+		m3 = _mm_mul_ps(m0, _mm_movehdup_ps(m1));
+
+		/* (ai * bi - aq * bq, aq * bi + ai * bq) */
+		_mm_storeu_ps(&out[2 * i], _mm_addsub_ps(m2, m3));
+	}
+
+	if (i < len)
+		base_mul_complex(&out[2 * i], &a[2 * i], &b[2 * i], len - i);
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Complex scaling
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "scale.h"
+#include "scale_sse_3.h"
+#include "scale_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Architecture dependent function pointers */
+struct scale_cpu_context {
+	void (*scale_complex) (float *, float *, float *, int);
+};
+
+static struct scale_cpu_context c;
+
+/* API: Initialize scale module */
+void scale_init(void)
+{
+	c.scale_complex = base_scale_complex;
+
+#ifdef HAVE___BUILTIN_CPU_SUPPORTS
+#ifdef HAVE_SSE3
+	if (__builtin_cpu_supports("sse3"))
+		c.scale_complex = sse_scale_complex;
+#endif
+
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		c.scale_complex = avx_scale_complex;
+#endif
+#endif
+}
+
+void scale_complex(float *out, float *in, float *scale, int len)
+{
+	c.scale_complex(out, in, scale, len);
+}
@@ -0,0 +1,54 @@
+/*
+ * AVX2 complex scaling
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "scale.h"
+#include "scale_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+
+/* Complex vector scaled by a complex constant with remainder */
+void avx_scale_complex(float *out, float *in, float *scale, int len)
+{
+	__m256 m0, m1, m2, m3;
+	int i;
+
+	/* Broadcast (bi, bi, ...) and (bq, bq, ...) */
+	m2 = _mm256_set1_ps(scale[0]);
+	m3 = _mm256_set1_ps(scale[1]);
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		/* Load (unaligned) four complex samples */
+		m0 = _mm256_loadu_ps(&in[2 * i]);
+
+		/* (aq * bq, ai * bq) */
+		m1 = _mm256_permute_ps(m0, _MM_SHUFFLE(2, 3, 0, 1));
+		m1 = _mm256_mul_ps(m1, m3);
+
+		/* (ai * bi - aq * bq, aq * bi + ai * bq) */
+		_mm256_storeu_ps(&out[2 * i], _mm256_fmaddsub_ps(m0, m2, m1));
+	}
+
+	if (i < len)
+		base_scale_complex(&out[2 * i], &in[2 * i], scale, len - i);
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "stats.h"
+#include "stats_sse_3.h"
+#include "stats_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Architecture dependent function pointers */
+struct stats_cpu_context {
+	void (*burst_stats) (const float *, int, int, float *, float *);
+	int (*argmax_norm2) (const float *, int, float *);
+};
+
+static struct stats_cpu_context c;
+
+/* API: Initialize statistics module */
+void stats_init(void)
+{
+	c.burst_stats = base_burst_stats;
+	c.argmax_norm2 = base_argmax_norm2;
+
+#ifdef HAVE___BUILTIN_CPU_SUPPORTS
+#ifdef HAVE_SSE3
+	if (__builtin_cpu_supports("sse3")) {
+		c.burst_stats = sse_burst_stats;
+		c.argmax_norm2 = sse_argmax_norm2;
+	}
+#endif
+
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		c.burst_stats = avx_burst_stats;
+		c.argmax_norm2 = avx_argmax_norm2;
+	}
+#endif
+#endif
+}
+
+void burst_stats(const float *in, int len, int win,
+		 float *energy, float *peak)
+{
+	c.burst_stats(in, len, win, energy, peak);
+}
+
+int argmax_norm2(const float *in, int len, float *max)
+{
+	return c.argmax_norm2(in, len, max);
+}
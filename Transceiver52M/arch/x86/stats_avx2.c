@@ -0,0 +1,129 @@
+/*
+ * AVX2 burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "stats.h"
+#include "stats_avx2.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+
+/* Fused windowed energy and peak amplitude with remainder */
+void avx_burst_stats(const float *in, int len, int win,
+		     float *energy, float *peak)
+{
+	__m256 m0, m1, m2, m3, m4;
+	__m128 r0, r1;
+	float e, p;
+	int i, n;
+
+	/* Sign bit clear mask and energy lane mask for the first sample */
+	m1 = _mm256_set1_ps(-0.0f);
+	m2 = _mm256_setr_ps(1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	m3 = _mm256_setzero_ps();
+	m4 = _mm256_setzero_ps();
+
+	n = len / 4 < win ? len / 4 : win;
+
+	/* One group of four samples per load inside the energy window */
+	for (i = 0; i < 4 * n; i += 4) {
+		m0 = _mm256_loadu_ps(&in[2 * i]);
+
+		m3 = _mm256_fmadd_ps(_mm256_mul_ps(m0, m2), m0, m3);
+		m4 = _mm256_max_ps(m4, _mm256_andnot_ps(m1, m0));
+	}
+
+	/* Remaining groups contribute to the peak only */
+	for (; i + 8 <= len; i += 8) {
+		m0 = _mm256_max_ps(_mm256_andnot_ps(m1, _mm256_loadu_ps(&in[2 * i + 0])),
+				   _mm256_andnot_ps(m1, _mm256_loadu_ps(&in[2 * i + 8])));
+		m4 = _mm256_max_ps(m4, m0);
+	}
+
+	if (i + 4 <= len) {
+		m4 = _mm256_max_ps(m4, _mm256_andnot_ps(m1, _mm256_loadu_ps(&in[2 * i])));
+		i += 4;
+	}
+
+	base_burst_stats(&in[2 * i], len - i, win - i / 4, &e, &p);
+
+	/* Energy sits in the two low lanes only */
+	r0 = _mm256_castps256_ps128(m3);
+	r0 = _mm_hadd_ps(r0, r0);
+
+	r1 = _mm_max_ps(_mm256_castps256_ps128(m4), _mm256_extractf128_ps(m4, 1));
+	r1 = _mm_max_ps(r1, _mm_movehl_ps(r1, r1));
+	r1 = _mm_max_ss(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	*energy = _mm_cvtss_f32(r0) + e;
+	*peak = _mm_cvtss_f32(r1) > p ? _mm_cvtss_f32(r1) : p;
+}
+
+/* Index of maximum squared magnitude with remainder */
+int avx_argmax_norm2(const float *in, int len, float *max)
+{
+	__m256 m0, m1, m2, m3, m4, m5, m6;
+	float vals[8], idxs[8], m = 0.0f, tail;
+	int i, index = -1, k;
+
+	m3 = _mm256_setzero_ps();
+	m4 = _mm256_set1_ps(-1.0f);
+	m6 = _mm256_set1_ps(8.0f);
+
+	/* Lane order produced by the in-lane horizontal add below */
+	m5 = _mm256_setr_ps(0.0f, 1.0f, 4.0f, 5.0f, 2.0f, 3.0f, 6.0f, 7.0f);
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		m0 = _mm256_loadu_ps(&in[2 * i + 0]);
+		m1 = _mm256_loadu_ps(&in[2 * i + 8]);
+
+		/* (|a0|^2, |a1|^2, |a4|^2, |a5|^2, |a2|^2, |a3|^2, ...) */
+		m0 = _mm256_hadd_ps(_mm256_mul_ps(m0, m0),
+				    _mm256_mul_ps(m1, m1));
+
+		/* Strictly greater keeps the first index in each lane */
+		m2 = _mm256_cmp_ps(m0, m3, _CMP_GT_OQ);
+		m3 = _mm256_max_ps(m0, m3);
+		m4 = _mm256_blendv_ps(m4, m5, m2);
+		m5 = _mm256_add_ps(m5, m6);
+	}
+
+	_mm256_storeu_ps(vals, m3);
+	_mm256_storeu_ps(idxs, m4);
+
+	for (k = 0; k < 8; k++) {
+		if ((vals[k] > m) ||
+		    ((vals[k] == m) && (m > 0.0f) && ((int) idxs[k] < index))) {
+			m = vals[k];
+			index = (int) idxs[k];
+		}
+	}
+
+	k = base_argmax_norm2(&in[2 * i], len - i, &tail);
+	if (tail > m) {
+		m = tail;
+		index = i + k;
+	}
+
+	*max = m;
+	return index;
+}
+#endif
@@ -0,0 +1,122 @@
+/*
+ * SSE burst statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "stats.h"
+#include "stats_sse_3.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_SSE3
+#include <xmmintrin.h>
+#include <pmmintrin.h>
+
+/* Fused windowed energy and peak amplitude with remainder */
+void sse_burst_stats(const float *in, int len, int win,
+		     float *energy, float *peak)
+{
+	__m128 m0, m1, m2, m3, m4, m5;
+	float e, p;
+	int i, n;
+
+	/* Sign bit clear mask and energy lane mask for the first sample */
+	m2 = _mm_set1_ps(-0.0f);
+	m3 = _mm_setr_ps(1.0f, 1.0f, 0.0f, 0.0f);
+	m4 = _mm_setzero_ps();
+	m5 = _mm_setzero_ps();
+
+	n = len / 4 < win ? len / 4 : win;
+
+	/* Groups of four samples inside the energy window */
+	for (i = 0; i < 4 * n; i += 4) {
+		m0 = _mm_loadu_ps(&in[2 * i + 0]);
+		m1 = _mm_loadu_ps(&in[2 * i + 4]);
+
+		m4 = _mm_add_ps(m4, _mm_mul_ps(_mm_mul_ps(m0, m3), m0));
+		m5 = _mm_max_ps(m5, _mm_andnot_ps(m2, m0));
+		m5 = _mm_max_ps(m5, _mm_andnot_ps(m2, m1));
+	}
+
+	/* Remaining groups contribute to the peak only */
+	for (; i + 4 <= len; i += 4) {
+		m0 = _mm_loadu_ps(&in[2 * i + 0]);
+		m1 = _mm_loadu_ps(&in[2 * i + 4]);
+
+		m5 = _mm_max_ps(m5, _mm_andnot_ps(m2, m0));
+		m5 = _mm_max_ps(m5, _mm_andnot_ps(m2, m1));
+	}
+
+	base_burst_stats(&in[2 * i], len - i, win - i / 4, &e, &p);
+
+	/* Horizontal sum and max */
+	m4 = _mm_hadd_ps(m4, m4);
+	m5 = _mm_max_ps(m5, _mm_movehl_ps(m5, m5));
+	m5 = _mm_max_ss(m5, _mm_shuffle_ps(m5, m5, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	*energy = _mm_cvtss_f32(m4) + e;
+	*peak = _mm_cvtss_f32(m5) > p ? _mm_cvtss_f32(m5) : p;
+}
+
+/* Index of maximum squared magnitude with remainder */
+int sse_argmax_norm2(const float *in, int len, float *max)
+{
+	__m128 m0, m1, m2, m3, m4, m5, m6;
+	float vals[4], idxs[4], m = 0.0f, tail;
+	int i, index = -1, k;
+
+	m3 = _mm_setzero_ps();
+	m4 = _mm_set1_ps(-1.0f);
+	m5 = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	m6 = _mm_set1_ps(4.0f);
+
+	for (i = 0; i + 4 <= len; i += 4) {
+		m0 = _mm_loadu_ps(&in[2 * i + 0]);
+		m1 = _mm_loadu_ps(&in[2 * i + 4]);
+
+		/* (|a0|^2, |a1|^2, |a2|^2, |a3|^2) */
+		m0 = _mm_hadd_ps(_mm_mul_ps(m0, m0), _mm_mul_ps(m1, m1));
+
+		/* Strictly greater keeps the first index in each lane */
+		m2 = _mm_cmpgt_ps(m0, m3);
+		m3 = _mm_max_ps(m0, m3);
+		m4 = _mm_or_ps(_mm_and_ps(m2, m5), _mm_andnot_ps(m2, m4));
+		m5 = _mm_add_ps(m5, m6);
+	}
+
+	_mm_storeu_ps(vals, m3);
+	_mm_storeu_ps(idxs, m4);
+
+	for (k = 0; k < 4; k++) {
+		if ((vals[k] > m) ||
+		    ((vals[k] == m) && (m > 0.0f) && ((int) idxs[k] < index))) {
+			m = vals[k];
+			index = (int) idxs[k];
+		}
+	}
+
+	k = base_argmax_norm2(&in[2 * i], len - i, &tail);
+	if (tail > m) {
+		m = tail;
+		index = i + k;
+	}
+
+	*max = m;
+	return index;
+}
+#endif
@@ -24,6 +24,7 @@
 
 #include "Transceiver.h"
 #include "radioDevice.h"
+#include "KernelTuner.h"
 #include "Utils.h"
 
 #include <time.h>
@@ -58,6 +59,9 @@ extern "C" {
 
 #include "convolve.h"
 #include "convert.h"
+#include "scale.h"
+#include "mult.h"
+#include "stats.h"
 #include "trx_vty.h"
 #include "debug.h"
 #include "osmo_signal.h"
@@ -65,6 +69,7 @@ extern "C" {
 }
 
 #define DEFAULT_CONFIG_FILE	"osmo-trx.cfg"
+#define KERNEL_CACHE_FILE	TRX_STATE_DIR "/kernels"
 
 #define charp2str(a) ((a) ? std::string(a) : std::string(""))
 
@@ -111,7 +116,7 @@ RadioInterface *makeRadioInterface(struct trx_ctx *trx,
 		return NULL;
 	}
 
-	if (!radio->init(type)) {
+	if (!radio->init(type, trx->cfg.half_buffers)) {
 		LOG(ALERT) << "Failed to initialize radio interface";
 		return NULL;
 	}
@@ -148,7 +153,9 @@ int makeTransceiver(struct trx_ctx *trx, RadioInterface *radio)
 			      trx->cfg.rx_sps, trx->cfg.num_chans, GSM::Time(3,0),
 			      radio, trx->cfg.rssi_offset, trx->cfg.stack_size);
 	if (!transceiver->init(trx->cfg.filler, trx->cfg.rtsc,
-		       trx->cfg.rach_delay, trx->cfg.egprs, trx->cfg.ext_rach)) {
+		       trx->cfg.rach_delay, trx->cfg.egprs, trx->cfg.ext_rach,
+		       trx->cfg.rx_snr_gate, trx->cfg.rx_toa_track,
+		       trx->cfg.rx_frame_batch)) {
 		LOG(ALERT) << "Failed to initialize transceiver";
 		return -1;
 	}
@@ -460,6 +467,11 @@ static void print_config(struct trx_ctx *trx)
 	ost << "   Rx Samples-per-Symbol... " << trx->cfg.rx_sps << std::endl;
 	ost << "   EDGE support............ " << trx->cfg.egprs << std::endl;
 	ost << "   Extended RACH support... " << trx->cfg.ext_rach << std::endl;
+	ost << "   Half precision buffers.. " << trx->cfg.half_buffers << std::endl;
+	ost << "   Kernel autotuning....... " << trx->cfg.kernel_autotune << std::endl;
+	ost << "   Rx SNR gate............. " << trx->cfg.rx_snr_gate << " dB" << std::endl;
+	ost << "   Rx TOA tracking......... " << trx->cfg.rx_toa_track << std::endl;
+	ost << "   Rx frame batching....... " << trx->cfg.rx_frame_batch << std::endl;
 	ost << "   Reference............... " << trx->cfg.clock_ref << std::endl;
 	ost << "   Filler Burst Type....... " << get_value_string(filler_names, trx->cfg.filler) << std::endl;
 	ost << "   Filler Burst TSC........ " << trx->cfg.rtsc << std::endl;
@@ -484,6 +496,25 @@ static void print_config(struct trx_ctx *trx)
 	LOG(INFO) << ost << std::endl;
 }
 
+/* Print the tuned convolution kernels for 'show trx kernels' */
+static void trx_dump_kernels(struct vty *vty)
+{
+	enum conv_kind kind;
+	const char *name;
+	int i, h_len;
+
+	if (!g_trx_ctx->cfg.kernel_autotune) {
+		vty_out(vty, "Kernel autotuning disabled%s", VTY_NEWLINE);
+		return;
+	}
+
+	vty_out(vty, "Kernel cache: %s%s", KERNEL_CACHE_FILE, VTY_NEWLINE);
+	for (i = 0; !convolve_selected(i, &kind, &h_len, &name); i++) {
+		vty_out(vty, " %-10s %3d taps: %s%s",
+			conv_kind_name(kind), h_len, name, VTY_NEWLINE);
+	}
+}
+
 static void trx_stop()
 {
 	LOG(NOTICE) << "Shutting down transceiver..." << std::endl;
@@ -519,6 +550,10 @@ static int trx_start(struct trx_ctx *trx)
 		goto shutdown;
 	}
 
+	/* Kernels are tuned as the filters are created from here on */
+	if (trx->cfg.kernel_autotune)
+		kernelTunerInit(KERNEL_CACHE_FILE);
+
 	/* Setup the appropriate device interface */
 	radio = makeRadioInterface(trx, usrp, type);
 	if (!radio)
@@ -582,6 +617,9 @@ int main(int argc, char *argv[])
 
 	convolve_init();
 	convert_init();
+	scale_init();
+	mult_init();
+	stats_init();
 
 	osmo_init_logging2(tall_trx_ctx, &log_info);
 	log_enable_multithread();
@@ -590,6 +628,7 @@ int main(int argc, char *argv[])
 	logging_vty_add_cmds();
 	ctrl_vty_init(tall_trx_ctx);
 	trx_vty_init(g_trx_ctx);
+	trx_vty_dump_kernels = trx_dump_kernels;
 
 	osmo_talloc_vty_add_cmds();
 	osmo_stats_vty_add_cmds();
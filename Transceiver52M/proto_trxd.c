@@ -21,6 +21,8 @@
  * See the COPYING file in the main directory for details.
  */
 
+#include <string.h>
+
 #include "proto_trxd.h"
 
 #include <osmocom/core/bits.h>
@@ -60,9 +62,8 @@ static void trxd_fill_v1_specific(struct trxd_hdr_v1_specific *v1, const struct
 
 static void trxd_fill_burst_normalized255(uint8_t* soft_bits, const struct trx_ul_burst_ind *bi)
 {
-	unsigned i;
-	for (i = 0; i < bi->nbits; i++)
-		soft_bits[i] = (uint8_t) round(bi->rx_burst[i] * 255.0);
+	/* Already quantized by the demodulator path */
+	memcpy(soft_bits, bi->soft_bits, bi->nbits);
 }
 
 bool trxd_send_burst_ind_v0(size_t chan, int fd, const struct trx_ul_burst_ind *bi) {
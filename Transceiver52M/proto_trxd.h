@@ -22,7 +22,7 @@ enum Modulation {
 };
 
 struct trx_ul_burst_ind {
-	float rx_burst[MAX_RX_BURST_BUF_SIZE]; /* soft bits normalized 0..1 */
+	uint8_t soft_bits[MAX_RX_BURST_BUF_SIZE]; /* soft bits normalized 0..255 */
 	unsigned nbits; // number of symbols per slot in rxBurst, not counting guard periods
 	uint32_t fn; // TDMA frame number
 	uint8_t tn; // TDMA time-slot number
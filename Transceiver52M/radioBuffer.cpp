@@ -26,20 +26,30 @@
 #include <iostream>
 #include "radioBuffer.h"
 
+extern "C" {
+#include "convert.h"
+}
+
 RadioBuffer::RadioBuffer(size_t numSegments, size_t segmentLen,
-			 size_t hLen, bool outDirection)
-	: writeIndex(0), readIndex(0), availSamples(0)
+			 size_t hLen, bool outDirection, bool half)
+	: writeIndex(0), readIndex(0), availSamples(0),
+	  halfBuffer(NULL), pending(-1)
 {
 	if (!outDirection)
 		hLen = 0;
 
-	buffer = new float[2 * (hLen + numSegments * segmentLen)];
 	bufferLen = numSegments * segmentLen;
 
-	segments.resize(numSegments);
+	if (half) {
+		halfBuffer = new unsigned short[2 * (hLen + bufferLen)]();
+		buffer = new float[2 * (hLen + segmentLen)];
+	} else {
+		buffer = new float[2 * (hLen + bufferLen)];
+		segments.resize(numSegments);
 
-	for (size_t i = 0; i < numSegments; i++)
-		segments[i] = &buffer[2 * (hLen + i * segmentLen)];
+		for (size_t i = 0; i < numSegments; i++)
+			segments[i] = &buffer[2 * (hLen + i * segmentLen)];
+	}
 
 	this->outDirection = outDirection;
 	this->numSegments = numSegments;
@@ -50,6 +60,7 @@ RadioBuffer::RadioBuffer(size_t numSegments, size_t segmentLen,
 RadioBuffer::~RadioBuffer()
 {
 	delete[] buffer;
+	delete[] halfBuffer;
 }
 
 void RadioBuffer::reset()
@@ -57,6 +68,57 @@ void RadioBuffer::reset()
 	writeIndex = 0;
 	readIndex = 0;
 	availSamples = 0;
+	pending = -1;
+}
+
+/*
+ * Sample storage
+ *
+ * Indices count complex samples from the start of the storage including the
+ * filter history. Half precision samples are converted on every copy.
+ */
+size_t RadioBuffer::sampleSize()
+{
+	return halfBuffer ? 2 * sizeof(unsigned short) : 2 * sizeof(float);
+}
+
+void *RadioBuffer::sampleAddr(size_t index)
+{
+	if (halfBuffer)
+		return &halfBuffer[2 * index];
+
+	return &buffer[2 * index];
+}
+
+void RadioBuffer::store(size_t index, const float *in, size_t len)
+{
+	if (halfBuffer)
+		convert_float_half(&halfBuffer[2 * index], in, 2 * len);
+	else
+		memcpy(&buffer[2 * index], in, len * 2 * sizeof(float));
+}
+
+void RadioBuffer::load(float *out, size_t index, size_t len)
+{
+	if (halfBuffer)
+		convert_half_float(out, &halfBuffer[2 * index], 2 * len);
+	else
+		memcpy(out, &buffer[2 * index], len * 2 * sizeof(float));
+}
+
+void RadioBuffer::clear(size_t index, size_t len)
+{
+	memset(sampleAddr(index), 0, len * sampleSize());
+}
+
+/* Store the input segment last returned by getWriteSegment() */
+void RadioBuffer::flush()
+{
+	if (pending < 0)
+		return;
+
+	store(pending * segmentLen, buffer, segmentLen);
+	pending = -1;
 }
 
 /*
@@ -84,14 +146,17 @@ const float *RadioBuffer::getReadSegment()
 		std::cout << "Invalid segment" << std::endl;
 		return NULL;
 	} else if (!num) {
-		memcpy(buffer,
-		       &buffer[2 * bufferLen],
-		       hLen * 2 * sizeof(float));
+		memcpy(sampleAddr(0), sampleAddr(bufferLen), hLen * sampleSize());
 	}
 
 	availSamples -= segmentLen;
 	readIndex = (readIndex + segmentLen) % bufferLen;
 
+	if (halfBuffer) {
+		load(buffer, num * segmentLen, hLen + segmentLen);
+		return &buffer[2 * hLen];
+	}
+
 	return segments[num];
 }
 
@@ -114,13 +179,12 @@ bool RadioBuffer::write(const float *wr, size_t len)
 	}
 
 	if (writeIndex + len <= bufferLen) {
-		memcpy(&buffer[2 * (writeIndex + hLen)],
-		       wr, len * 2 * sizeof(float));
+		store(writeIndex + hLen, wr, len);
 	} else {
 		size_t len0 = bufferLen - writeIndex;
 		size_t len1 = len - len0;
-		memcpy(&buffer[2 * (writeIndex + hLen)], wr, len0 * 2 * sizeof(float));
-		memcpy(&buffer[2 * hLen], &wr[2 * len0], len1 * 2 * sizeof(float));
+		store(writeIndex + hLen, wr, len0);
+		store(hLen, &wr[2 * len0], len1);
 	}
 
 	availSamples += len;
@@ -143,13 +207,12 @@ bool RadioBuffer::zero(size_t len)
 	}
 
 	if (writeIndex + len <= bufferLen) {
-		memset(&buffer[2 * (writeIndex + hLen)],
-		       0, len * 2 * sizeof(float));
+		clear(writeIndex + hLen, len);
 	} else {
 		size_t len0 = bufferLen - writeIndex;
 		size_t len1 = len - len0;
-		memset(&buffer[2 * (writeIndex + hLen)], 0, len0 * 2 * sizeof(float));
-		memset(&buffer[2 * hLen], 0, len1 * 2 * sizeof(float));
+		clear(writeIndex + hLen, len0);
+		clear(hLen, len1);
 	}
 
 	availSamples += len;
@@ -187,6 +250,12 @@ float *RadioBuffer::getWriteSegment()
 	availSamples += segmentLen;
 	writeIndex = (writeIndex + segmentLen) % bufferLen;
 
+	if (halfBuffer) {
+		flush();
+		pending = num;
+		return buffer;
+	}
+
 	return segments[num];
 }
 
@@ -214,13 +283,15 @@ bool RadioBuffer::read(float *rd, size_t len)
 		return false;
 	}
 
+	flush();
+
 	if (readIndex + len <= bufferLen) {
-		memcpy(rd, &buffer[2 * readIndex], len * 2 * sizeof(float));
+		load(rd, readIndex, len);
 	} else {
 		size_t len0 = bufferLen - readIndex;
 		size_t len1 = len - len0;
-		memcpy(rd, &buffer[2 * readIndex], len0 * 2 * sizeof(float));
-		memcpy(&rd[2 * len0], buffer, len1 * 2 * sizeof(float));
+		load(rd, readIndex, len0);
+		load(&rd[2 * len0], 0, len1);
 	}
 
 	availSamples -= len;
@@ -1,11 +1,12 @@
 #include <stdlib.h>
 #include <stddef.h>
+#include <sys/types.h>
 #include <vector>
 
 class RadioBuffer {
 public:
 	RadioBuffer(size_t numSegments, size_t segmentLen,
-		    size_t hLen, bool outDirection);
+		    size_t hLen, bool outDirection, bool half = false);
 
 	~RadioBuffer();
 
@@ -37,9 +38,24 @@ public:
 	bool read(float *rd, size_t len);
 
 private:
+	size_t sampleSize();
+	void *sampleAddr(size_t index);
+	void store(size_t index, const float *in, size_t len);
+	void load(float *out, size_t index, size_t len);
+	void clear(size_t index, size_t len);
+	void flush();
+
 	size_t writeIndex, readIndex, availSamples;
 	size_t bufferLen, numSegments, segmentLen, hLen;
 	float *buffer;
 	std::vector<float *> segments;
 	bool outDirection;
+
+	/*
+	 * Half precision storage. The float buffer then only holds the
+	 * segment handed out to the caller, plus filter history on output,
+	 * and a pending input segment is stored on the next buffer access.
+	 */
+	unsigned short *halfBuffer;
+	ssize_t pending;
 };
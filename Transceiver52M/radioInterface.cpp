@@ -48,7 +48,7 @@ RadioInterface::~RadioInterface(void)
   close();
 }
 
-bool RadioInterface::init(int type)
+bool RadioInterface::init(int type, bool half_buffers)
 {
   if ((type != RadioDevice::NORMAL) || !mChans) {
     LOG(ALERT) << "Invalid configuration";
@@ -65,8 +65,10 @@ bool RadioInterface::init(int type)
   powerScaling.resize(mChans);
 
   for (size_t i = 0; i < mChans; i++) {
-    sendBuffer[i] = new RadioBuffer(NUMCHUNKS, CHUNK * mSPSTx, 0, true);
-    recvBuffer[i] = new RadioBuffer(NUMCHUNKS, CHUNK * mSPSRx, 0, false);
+    sendBuffer[i] = new RadioBuffer(NUMCHUNKS, CHUNK * mSPSTx, 0, true,
+                                    half_buffers);
+    recvBuffer[i] = new RadioBuffer(NUMCHUNKS, CHUNK * mSPSRx, 0, false,
+                                    half_buffers);
 
     convertSendBuffer[i] = new short[CHUNK * mSPSTx * 2];
     convertRecvBuffer[i] = new short[CHUNK * mSPSRx * 2];
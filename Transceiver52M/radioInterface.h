@@ -80,7 +80,7 @@ public:
   bool stop();
 
   /** initialization */
-  virtual bool init(int type);
+  virtual bool init(int type, bool half_buffers);
   virtual void close();
 
   /** constructor */
@@ -151,7 +151,7 @@ public:
   RadioInterfaceResamp(RadioDevice* wDevice, size_t tx_sps, size_t rx_sps);
   ~RadioInterfaceResamp();
 
-  bool init(int type);
+  bool init(int type, bool half_buffers);
   void close();
 };
 
@@ -184,7 +184,7 @@ public:
                       size_t rx_sps, size_t chans = 1);
   ~RadioInterfaceMulti();
 
-  bool init(int type);
+  bool init(int type, bool half_buffers);
   void close();
 
   bool tuneTx(double freq, size_t chan);
@@ -130,7 +130,7 @@ static int getFreqShift(size_t chans)
 }
 
 /* Initialize I/O specific objects */
-bool RadioInterfaceMulti::init(int type)
+bool RadioInterfaceMulti::init(int type, bool half_buffers)
 {
 	float cutoff = 1.0f;
 	size_t inchunk = 0, outchunk = 0;
@@ -194,9 +194,10 @@ bool RadioInterfaceMulti::init(int type)
 	 */
 	for (size_t i = 0; i < mChans; i++) {
 		sendBuffer[i] = new RadioBuffer(NUMCHUNKS, inchunk,
-					        upsampler->len(), true);
+					        upsampler->len(), true,
+					        half_buffers);
 		recvBuffer[i] = new RadioBuffer(NUMCHUNKS, inchunk,
-		                                0, false);
+		                                0, false, half_buffers);
 		history[i] = new signalVector(dnsampler->len());
 
 		synthesis->resetBuffer(i);
@@ -94,7 +94,7 @@ void RadioInterfaceResamp::close()
 }
 
 /* Initialize I/O specific objects */
-bool RadioInterfaceResamp::init(int type)
+bool RadioInterfaceResamp::init(int type, bool half_buffers)
 {
 	float cutoff = 1.0f;
 
@@ -147,8 +147,9 @@ bool RadioInterfaceResamp::init(int type)
 	 * rate buffers are allocated in the main radio interface code.
 	 */
 	sendBuffer[0] = new RadioBuffer(NUMCHUNKS, resamp_inchunk,
-					  upsampler->len(), true);
-	recvBuffer[0] = new RadioBuffer(NUMCHUNKS * 20, resamp_inchunk, 0, false);
+					  upsampler->len(), true, half_buffers);
+	recvBuffer[0] = new RadioBuffer(NUMCHUNKS * 20, resamp_inchunk, 0, false,
+					  half_buffers);
 
 	outerSendBuffer =
 		new signalVector(NUMCHUNKS * resamp_outchunk);
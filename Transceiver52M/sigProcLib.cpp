@@ -32,21 +32,39 @@
 #include "GSMCommon.h"
 #include "Logger.h"
 #include "Resampler.h"
+#include "FFTCorrelator.h"
+#include "KernelTuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
 
 extern "C" {
 #include "convolve.h"
+#include "convert.h"
 #include "scale.h"
 #include "mult.h"
+#include "stats.h"
 }
 
 using namespace GSM;
 
 #define TABLESIZE		1024
 #define DELAYFILTS		64
+#define PEAKFILTS		256
+#define PEAKFILT_LEN		16
 
 /* Clipping detection threshold */
 #define CLIP_THRESH		30000.0f
 
+/* Repetitions per FFT correlator crossover timing run */
+#define XOVER_REPS		64
+#define XOVER_RUNS		5
+
+/* Search window used to choose between interleaved and planar correlation */
+#define PLANAR_XOVER_LEN	48
+
 /** Lookup tables for trigonometric approximation */
 static float sincTable[TABLESIZE+1]; // add 1 element for wrap around
 
@@ -62,6 +80,9 @@ static signalVector *GMSKReverseRotation1 = NULL;
 /* Precomputed fractional delay filters */
 static signalVector *delayFilters[DELAYFILTS];
 
+/* Precomputed sub-sample peak interpolation filters */
+static signalVector *peakFilters[PEAKFILTS];
+
 static const Complex<float> psk8_table[8] = {
    Complex<float>(-0.70710678,  0.70710678),
    Complex<float>( 0.0, -1.0),
@@ -73,12 +94,34 @@ static const Complex<float> psk8_table[8] = {
    Complex<float>( 1.0,  0.0),
 };
 
+/*
+ * EDGE 3pi/8 symbol rotation repeats every 16 symbols. Keep the rotated 8-PSK
+ * constellation for each position so that mapping needs a single lookup, and
+ * the inverse rotation with the -pi/8 offset of the soft slicer folded in.
+ */
+static Complex<float> psk8RotTable[16][8];
+static Complex<float> edgeDerotTable[16];
+
 /* Downsampling filterbank - 4 SPS to 1 SPS */
 #define DOWNSAMPLE_IN_LEN	624
 #define DOWNSAMPLE_OUT_LEN	156
 
+/* Largest demodulator output, 1 SPS GMSK bursts fit with guard symbols */
+#define DEMOD_MAX_NBITS		EDGE_BURST_NBITS
+
 static Resampler *dnsampler = NULL;
 
+/*
+ * Fractional delay filters combined with the downsampler for 4 SPS timing
+ * recovery, with one more filter for integer sample delays
+ */
+#define DEMODFILT_LEN		36
+
+static complex *demodFilters = NULL;
+static int demodOffset;
+static int demodIndex[DOWNSAMPLE_OUT_LEN];
+static int demodPath[DOWNSAMPLE_OUT_LEN];
+
 /*
  * RACH and midamble correlation waveforms. Store the buffer separately
  * because we need to allocate it explicitly outside of the signal vector
@@ -86,19 +129,28 @@ static Resampler *dnsampler = NULL;
  * perform 16-byte memory alignment required by many SSE instructions.
  */
 struct CorrelationSequence {
-  CorrelationSequence() : sequence(NULL), buffer(NULL), toa(0.0)
+  CorrelationSequence() : sequence(NULL), buffer(NULL), toa(0.0),
+                          fft(NULL), fftMinLen(0)
   {
   }
 
   ~CorrelationSequence()
   {
     delete sequence;
+    delete fft;
   }
 
   signalVector *sequence;
   void         *buffer;
   float        toa;
   complex      gain;
+
+  /* Overlap-save correlator used for search windows of fftMinLen or more */
+  FFTCorrelator *fft;
+  size_t        fftMinLen;
+
+  /* Split I/Q copy of the sequence for the direct correlator */
+  std::vector<float> planar;
 };
 
 /*
@@ -128,6 +180,14 @@ struct PulseSequence {
 static CorrelationSequence *gMidambles[] = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL};
 static CorrelationSequence *gEdgeMidambles[] = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL};
 static CorrelationSequence *gRACHSequences[] = {NULL,NULL,NULL};
+
+/*
+ * Split I/Q taps of the RACH sequences and of the midambles for the
+ * multi-sequence correlator. Real parts of every sequence come first, then
+ * the imaginary parts. Empty if correlating one by one is faster.
+ */
+static std::vector<float> gRACHPlanar;
+static std::vector<float> gMidamblePlanar;
 static PulseSequence *GSMPulse1 = NULL;
 static PulseSequence *GSMPulse4 = NULL;
 
@@ -145,10 +205,17 @@ void sigProcLibDestroy()
     delayFilters[i] = NULL;
   }
 
+  for (int i = 0; i < PEAKFILTS; i++) {
+    delete peakFilters[i];
+    peakFilters[i] = NULL;
+  }
+
   for (int i = 0; i < 3; i++) {
     delete gRACHSequences[i];
     gRACHSequences[i] = NULL;
   }
+  gRACHPlanar.clear();
+  gMidamblePlanar.clear();
 
   delete GMSKRotation1;
   delete GMSKReverseRotation1;
@@ -157,6 +224,7 @@ void sigProcLibDestroy()
   delete GSMPulse1;
   delete GSMPulse4;
   delete dnsampler;
+  free(demodFilters);
 
   GMSKRotation1 = NULL;
   GMSKRotation4 = NULL;
@@ -164,6 +232,8 @@ void sigProcLibDestroy()
   GMSKReverseRotation1 = NULL;
   GSMPulse1 = NULL;
   GSMPulse4 = NULL;
+  dnsampler = NULL;
+  demodFilters = NULL;
 }
 
 static float vectorNorm2(const signalVector &x)
@@ -206,77 +276,112 @@ static void initGMSKRotationTables()
   }
 }
 
-static void GMSKRotate(signalVector &x, int sps)
+/*
+ * Initialize EDGE rotated 8-PSK and derotation tables
+ */
+static void initEdgeRotationTables()
 {
-#if HAVE_NEON
-  size_t len;
-  signalVector *a, *b, *out;
-
-  a = &x;
-  out = &x;
-  len = out->size();
+  for (int i = 0; i < 16; i++) {
+    double phase = i * 3.0 * M_PI / 8.0;
+    Complex<float> rot = Complex<float>(cos(phase), sin(phase));
 
-  if (len == 157)
-    len--;
+    for (int n = 0; n < 8; n++)
+      psk8RotTable[i][n] = psk8_table[n] * rot;
 
-  if (sps == 1)
-    b = GMSKRotation1;
-  else
-    b = GMSKRotation4;
+    edgeDerotTable[i] = Complex<float>(cos(-phase - M_PI / 8.0),
+                                       sin(-phase - M_PI / 8.0));
+  }
+}
 
-  mul_complex((float *) out->begin(),
-              (float *) a->begin(),
-              (float *) b->begin(), len);
-#else
-  signalVector::iterator rotPtr, xPtr = x.begin();
+/*
+ * Real-valued bursts keep a zero imaginary part, so both the real and complex
+ * cases go through the (vectorized) complex multiply.
+ */
+static void GMSKRotate(signalVector &x, int sps)
+{
+  signalVector *rot;
 
   if (sps == 1)
-    rotPtr = GMSKRotation1->begin();
+    rot = GMSKRotation1;
   else
-    rotPtr = GMSKRotation4->begin();
+    rot = GMSKRotation4;
 
-  if (x.isReal()) {
-    while (xPtr < x.end()) {
-      *xPtr = *rotPtr++ * (xPtr->real());
-      xPtr++;
-    }
-  }
-  else {
-    while (xPtr < x.end()) {
-      *xPtr = *rotPtr++ * (*xPtr);
-      xPtr++;
-    }
-  }
-#endif
+  mul_complex((float *) x.begin(),
+              (float *) x.begin(),
+              (float *) rot->begin(), x.size());
 }
 
-static bool GMSKReverseRotate(signalVector &x, int sps)
+/*
+ * Reverse rotation of a 1 SPS GMSK burst with single tap channel correction,
+ * keeping only the real part of the first len symbols as soft decisions. The
+ * channel gain is folded into the rotation so that each symbol takes one
+ * complex multiply, and the imaginary part is never computed.
+ */
+static bool GMSKReverseRotateSoft(const signalVector &x, complex gain,
+                                  float *bits, size_t len)
 {
-  signalVector::iterator rotPtr, xPtr= x.begin();
+  const complex *rot = GMSKReverseRotation1->begin();
 
-  if (sps == 1)
-    rotPtr = GMSKReverseRotation1->begin();
-  else if (sps == 4)
-    rotPtr = GMSKReverseRotation4->begin();
-  else
+  if ((len > x.size()) || (len > GMSKReverseRotation1->size()))
     return false;
 
-  if (x.isReal()) {
-    while (xPtr < x.end()) {
-      *xPtr = *rotPtr++ * (xPtr->real());
-      xPtr++;
-    }
-  }
-  else {
-    while (xPtr < x.end()) {
-      *xPtr = *rotPtr++ * (*xPtr);
-      xPtr++;
-    }
+  for (size_t i = 0; i < len; i++) {
+    complex w = rot[i] * gain;
+    bits[i] = x[i].real() * w.real() - x[i].imag() * w.imag();
   }
 
   return true;
 }
 
+SigProcWorkspace::SigProcWorkspace()
+  : corr(0, convolve_h_alloc, free), window(0, convolve_h_alloc, free),
+    dec(0, convolve_h_alloc, free), edge(0, convolve_h_alloc, free),
+    c0(0, convolve_h_alloc, free),
+    c1(0, convolve_h_alloc, free), shaped(0, convolve_h_alloc, free)
+{
+}
+
+/* Workspace for the functions called without one, e.g. at setup */
+static SigProcWorkspace &threadWorkspace()
+{
+  static thread_local SigProcWorkspace ws;
+  return ws;
+}
+
+/*
+ * Grow a workspace buffer to hold at least len samples. Views of the
+ * buffer are created with keepBuffer() as free function, so that they
+ * never release it.
+ */
+static complex *reserveBuffer(signalVector &buf, size_t len)
+{
+  if (buf.size() < len)
+    buf.resize(len);
+
+  return buf.begin();
+}
+
+static void keepBuffer(void *)
+{
+}
+
+/* Zero filled workspace buffer of len samples */
+static complex *reserveZeroed(signalVector &buf, size_t len)
+{
+  complex *data = reserveBuffer(buf, len);
+
+  std::fill(data, data + len, complex(0.0f));
+
+  return data;
+}
+
+/* Set the size of an output vector, keeping its buffer if the size matches */
+static void resizeVector(signalVector &x, size_t len)
+{
+  if (x.size() != len)
+    x.resize(len);
+}
+
 /** Convolution type indicator */
 enum ConvType {
   START_ONLY,
@@ -285,14 +390,52 @@ enum ConvType {
   UNDEFINED,
 };
 
+/*
+ * Four convolve types:
+ *   1. Complex-Real (aligned)
+ *   2. Complex-Complex (aligned)
+ *   3. Complex-Real (!aligned)
+ *   4. Complex-Complex (!aligned)
+ */
+static int convolveSpan(const signalVector *x, const signalVector *h,
+                        signalVector *y, size_t start, size_t len)
+{
+  if (h->isReal() && h->isAligned()) {
+    return convolve_real((float *) x->begin(), x->size(),
+                         (float *) h->begin(), h->size(),
+                         (float *) y->begin(), y->size(),
+                         start, len);
+  } else if (!h->isReal() && h->isAligned()) {
+    return convolve_complex((float *) x->begin(), x->size(),
+                            (float *) h->begin(), h->size(),
+                            (float *) y->begin(), y->size(),
+                            start, len);
+  } else if (h->isReal() && !h->isAligned()) {
+    return base_convolve_real((float *) x->begin(), x->size(),
+                              (float *) h->begin(), h->size(),
+                              (float *) y->begin(), y->size(),
+                              start, len);
+  } else {
+    return base_convolve_complex((float *) x->begin(), x->size(),
+                                 (float *) h->begin(), h->size(),
+                                 (float *) y->begin(), y->size(),
+                                 start, len);
+  }
+}
+
+/*
+ * Convolve x with h. Output is written to y, or to a new vector if y is NULL.
+ * Spans extending past x are zero padded in a copy of x, held in pad unless
+ * NULL.
+ */
 static signalVector *convolve(const signalVector *x, const signalVector *h,
                               signalVector *y, ConvType spanType,
-                              size_t start = 0, size_t len = 0)
+                              size_t start = 0, size_t len = 0,
+                              signalVector *pad = NULL)
 {
   int rc;
   size_t head = 0, tail = 0;
   bool alloc = false, append = false;
-  const signalVector *_x = NULL;
 
   if (!x || !h)
     return NULL;
@@ -339,45 +482,23 @@ static signalVector *convolve(const signalVector *x, const signalVector *h,
   }
 
   /* Prepend or post-pend the input vector if the parameters require it */
-  if (append)
-    _x = new signalVector(*x, head, tail);
-  else
-    _x = x;
-
-  /*
-   * Four convolve types:
-   *   1. Complex-Real (aligned)
-   *   2. Complex-Complex (aligned)
-   *   3. Complex-Real (!aligned)
-   *   4. Complex-Complex (!aligned)
-   */
-  if (h->isReal() && h->isAligned()) {
-    rc = convolve_real((float *) _x->begin(), _x->size(),
-                       (float *) h->begin(), h->size(),
-                       (float *) y->begin(), y->size(),
-                       start, len);
-  } else if (!h->isReal() && h->isAligned()) {
-    rc = convolve_complex((float *) _x->begin(), _x->size(),
-                          (float *) h->begin(), h->size(),
-                          (float *) y->begin(), y->size(),
-                          start, len);
-  } else if (h->isReal() && !h->isAligned()) {
-    rc = base_convolve_real((float *) _x->begin(), _x->size(),
-                            (float *) h->begin(), h->size(),
-                            (float *) y->begin(), y->size(),
-                            start, len);
-  } else if (!h->isReal() && !h->isAligned()) {
-    rc = base_convolve_complex((float *) _x->begin(), _x->size(),
-                               (float *) h->begin(), h->size(),
-                               (float *) y->begin(), y->size(),
-                               start, len);
+  if (append && pad) {
+    complex *data = reserveBuffer(*pad, head + x->size() + tail);
+    signalVector padded(data, head, x->size() + tail, NULL, keepBuffer);
+
+    std::fill(data, data + head, complex(0.0f));
+    std::copy(x->begin(), x->end(), padded.begin());
+    std::fill(padded.begin() + x->size(), padded.end(), complex(0.0f));
+    rc = convolveSpan(&padded, h, y, start, len);
+  } else if (append) {
+    signalVector *padded = new signalVector(*x, head, tail);
+
+    rc = convolveSpan(padded, h, y, start, len);
+    delete padded;
   } else {
-    rc = -1;
+    rc = convolveSpan(x, h, y, start, len);
   }
 
-  if (append)
-    delete _x;
-
   if (rc < 0) {
     if (alloc)
       delete y;
@@ -532,49 +653,29 @@ static PulseSequence *generateGSMPulse(int sps)
   return pulse;
 }
 
-/* Convert -1..+1 soft bits to 0..1 soft bits */
-void vectorSlicer(float *dest, const float *src, size_t len)
-{
-	size_t i;
-	for (i = 0; i < len; i++) {
-		dest[i] = 0.5 * (src[i] + 1.0f);
-		if (dest[i] > 1.0)
-			dest[i] = 1.0;
-		else if (dest[i] < 0.0)
-			dest[i] = 0.0;
-	}
-}
-
-static signalVector *rotateBurst(const BitVector &wBurst,
-                                 int guardPeriodLength, int sps)
+/*
+ * Rotation only, the empty pulse is a single unity tap so that no filter
+ * operation is needed
+ */
+static bool rotateBurst(const BitVector &wBurst, int guardPeriodLength,
+                        int sps, signalVector &out)
 {
   int burst_len;
-  signalVector *pulse, rotated;
   signalVector::iterator itr;
 
-  pulse = GSMPulse1->empty;
   burst_len = sps * (wBurst.size() + guardPeriodLength);
-  rotated = signalVector(burst_len);
-  itr = rotated.begin();
+  resizeVector(out, burst_len);
+  out.fill(0.0f);
+  itr = out.begin();
 
   for (unsigned i = 0; i < wBurst.size(); i++) {
     *itr = 2.0 * (wBurst[i] & 0x01) - 1.0;
     itr += sps;
   }
 
-  GMSKRotate(rotated, sps);
-  rotated.isReal(false);
-
-  /* Dummy filter operation */
-  return convolve(&rotated, pulse, NULL, START_ONLY);
-}
-
-static void rotateBurst2(signalVector &burst, double phase)
-{
-  Complex<float> rot = Complex<float>(cos(phase), sin(phase));
+  GMSKRotate(out, sps);
 
-  for (size_t i = 0; i < burst.size(); i++)
-    burst[i] = burst[i] * rot;
+  return true;
 }
 
 /*
@@ -582,26 +683,29 @@ static void rotateBurst2(signalVector &burst, double phase)
  * because it results in 624/628 sized bursts instead of the preferred
  * burst length of 625. Only 4 SPS is supported.
  */
-static signalVector *modulateBurstLaurent(const BitVector &bits)
+static bool modulateBurstLaurent(const BitVector &bits, signalVector &out,
+                                 SigProcWorkspace &ws)
 {
   int burst_len, sps = 4;
   float phase;
-  signalVector *c0_pulse, *c1_pulse, *c0_shaped, *c1_shaped;
+  signalVector *c0_pulse, *c1_pulse;
   signalVector::iterator c0_itr, c1_itr;
 
   c0_pulse = GSMPulse4->c0;
   c1_pulse = GSMPulse4->c1;
 
   if (bits.size() > 156)
-    return NULL;
+    return false;
 
   burst_len = 625;
 
-  signalVector c0_burst(burst_len, c0_pulse->size());
+  signalVector c0_burst(reserveZeroed(ws.c0, c0_pulse->size() + burst_len),
+                        c0_pulse->size(), burst_len, NULL, keepBuffer);
   c0_burst.isReal(true);
   c0_itr = c0_burst.begin();
 
-  signalVector c1_burst(burst_len, c1_pulse->size());
+  signalVector c1_burst(reserveZeroed(ws.c1, c1_pulse->size() + burst_len),
+                        c1_pulse->size(), burst_len, NULL, keepBuffer);
   c1_itr = c1_burst.begin();
 
   /* Padded differential tail bits */
@@ -646,76 +750,48 @@ static signalVector *modulateBurstLaurent(const BitVector &bits)
   *c1_itr = *c0_itr * Complex<float>(0, phase);
 
   /* Primary (C0) and secondary (C1) pulse shaping */
-  c0_shaped = convolve(&c0_burst, c0_pulse, NULL, START_ONLY);
-  c1_shaped = convolve(&c1_burst, c1_pulse, NULL, START_ONLY);
+  signalVector c1_shaped(reserveBuffer(ws.shaped, burst_len), 0, burst_len,
+                         NULL, keepBuffer);
+  resizeVector(out, burst_len);
+  if (!convolve(&c0_burst, c0_pulse, &out, START_ONLY) ||
+      !convolve(&c1_burst, c1_pulse, &c1_shaped, START_ONLY))
+    return false;
 
   /* Sum shaped outputs into C0 */
-  c0_itr = c0_shaped->begin();
-  c1_itr = c1_shaped->begin();
-  for (unsigned i = 0; i < c0_shaped->size(); i++ )
+  c0_itr = out.begin();
+  c1_itr = c1_shaped.begin();
+  for (unsigned i = 0; i < out.size(); i++ )
     *c0_itr++ += *c1_itr++;
 
-  delete c1_shaped;
-  return c0_shaped;
-}
-
-static signalVector *rotateEdgeBurst(const signalVector &symbols, int sps)
-{
-  signalVector *burst;
-  signalVector::iterator burst_itr;
-
-  burst = new signalVector(symbols.size() * sps);
-  burst_itr = burst->begin();
-
-  for (size_t i = 0; i < symbols.size(); i++) {
-    float phase = i * 3.0f * M_PI / 8.0f;
-    Complex<float> rot = Complex<float>(cos(phase), sin(phase));
-
-    *burst_itr = symbols[i] * rot;
-    burst_itr += sps;
-  }
-
-  return burst;
+  return true;
 }
 
-static signalVector *derotateEdgeBurst(const signalVector &symbols, int sps)
+/*
+ * Map 3-bit groups onto rotated 8-PSK symbols, writing every sps'th sample
+ */
+static void mapEdgeSymbols(const BitVector &bits, size_t nsyms,
+                           signalVector::iterator out, int sps)
 {
-  signalVector *burst;
-  signalVector::iterator burst_itr;
-
-  if (symbols.size() % sps)
-    return NULL;
-
-  burst = new signalVector(symbols.size() / sps);
-  burst_itr = burst->begin();
-
-  for (size_t i = 0; i < burst->size(); i++) {
-    float phase = (float) (i % 16) * 3.0f * M_PI / 8.0f;
-    Complex<float> rot = Complex<float>(cosf(phase), -sinf(phase));
+  for (size_t i = 0; i < nsyms; i++) {
+    unsigned index = (((unsigned) bits[3 * i + 0] & 0x01) << 0) |
+                     (((unsigned) bits[3 * i + 1] & 0x01) << 1) |
+                     (((unsigned) bits[3 * i + 2] & 0x01) << 2);
 
-    *burst_itr = symbols[sps * i] * rot;
-    burst_itr++;
+    *out = psk8RotTable[i % 16][index];
+    out += sps;
   }
-
-  return burst;
 }
 
-static signalVector *mapEdgeSymbols(const BitVector &bits)
+static bool rotateEdgeBurst(const BitVector &bits, int sps, signalVector &out)
 {
-  if (bits.size() % 3)
-    return NULL;
-
-  signalVector *symbols = new signalVector(bits.size() / 3);
+  size_t nsyms = bits.size() / 3;
 
-  for (size_t i = 0; i < symbols->size(); i++) {
-    unsigned index = (((unsigned) bits[3 * i + 0] & 0x01) << 0) |
-                     (((unsigned) bits[3 * i + 1] & 0x01) << 1) |
-                     (((unsigned) bits[3 * i + 2] & 0x01) << 2);
+  resizeVector(out, nsyms * sps);
+  out.fill(0.0f);
 
-    (*symbols)[i] = psk8_table[index];
-  }
+  mapEdgeSymbols(bits, nsyms, out.begin(), sps);
 
-  return symbols;
+  return true;
 }
 
 /*
@@ -726,30 +802,25 @@ static signalVector *mapEdgeSymbols(const BitVector &bits)
  * pulse filter combination of the GMSK Laurent representation whereas 8-PSK
  * uses a single pulse linear filter.
  */
-static signalVector *shapeEdgeBurst(const signalVector &symbols)
+static bool shapeEdgeBurst(const BitVector &bits, signalVector &out,
+                           SigProcWorkspace &ws)
 {
-  size_t nsyms, nsamps = 625, sps = 4;
-  signalVector::iterator burst_itr;
+  size_t nsyms, nsamps = 625, sps = 4, head = GSMPulse4->c0->size();
 
-  nsyms = symbols.size();
+  nsyms = bits.size() / 3;
 
   if (nsyms * sps > nsamps)
     nsyms = 156;
 
-  signalVector burst(nsamps, GSMPulse4->c0->size());
+  signalVector burst(reserveZeroed(ws.c0, head + nsamps), head, nsamps,
+                     NULL, keepBuffer);
 
   /* Delay burst by 1 symbol */
-  burst_itr = burst.begin() + sps;
-  for (size_t i = 0; i < nsyms; i++) {
-    float phase = i * 3.0f * M_PI / 8.0f;
-    Complex<float> rot = Complex<float>(cos(phase), sin(phase));
-
-    *burst_itr = symbols[i] * rot;
-    burst_itr += sps;
-  }
+  mapEdgeSymbols(bits, nsyms, burst.begin() + sps, sps);
 
   /* Single Gaussian pulse approximation shaping */
-  return convolve(&burst, GSMPulse4->c0, NULL, START_ONLY);
+  resizeVector(out, nsamps);
+  return convolve(&burst, GSMPulse4->c0, &out, START_ONLY) != NULL;
 }
 
 /*
@@ -864,36 +935,39 @@ signalVector *generateEdgeBurst(int tsc)
   if ((tsc < 0) || (tsc > 7))
     return NULL;
 
-  signalVector burst(148);
+  BitVector bits(444);
   const BitVector *midamble = &gEdgeTrainingSequence[tsc];
 
   /* Tail */
   int n, i = 0;
-  for (; i < tail; i++)
-    burst[i] = psk8_table[7];
+  for (; i < 3 * tail; i++)
+    bits[i] = 1;
 
   /* Body */
-  for (; i < tail + data; i++)
-    burst[i] = psk8_table[rand() % 8];
+  for (; i < 3 * (tail + data); i += 3) {
+    unsigned index = rand() % 8;
+    bits[i + 0] = (index >> 0) & 0x01;
+    bits[i + 1] = (index >> 1) & 0x01;
+    bits[i + 2] = (index >> 2) & 0x01;
+  }
 
   /* TSC */
-  for (n = 0; i < tail + data + train; i++, n++) {
-    unsigned index = (((unsigned) (*midamble)[3 * n + 0] & 0x01) << 0) |
-                     (((unsigned) (*midamble)[3 * n + 1] & 0x01) << 1) |
-                     (((unsigned) (*midamble)[3 * n + 2] & 0x01) << 2);
-
-    burst[i] = psk8_table[index];
-  }
+  for (n = 0; i < 3 * (tail + data + train); i++, n++)
+    bits[i] = (*midamble)[n];
 
   /* Body */
-  for (; i < tail + data + train + data; i++)
-    burst[i] = psk8_table[rand() % 8];
+  for (; i < 3 * (tail + data + train + data); i += 3) {
+    unsigned index = rand() % 8;
+    bits[i + 0] = (index >> 0) & 0x01;
+    bits[i + 1] = (index >> 1) & 0x01;
+    bits[i + 2] = (index >> 2) & 0x01;
+  }
 
   /* Tail */
-  for (; i < tail + data + train + data + tail; i++)
-    burst[i] = psk8_table[7];
+  for (; i < 3 * (tail + data + train + data + tail); i++)
+    bits[i] = 1;
 
-  return shapeEdgeBurst(burst);
+  return modulateEdgeBurst(bits, 4);
 }
 
 /*
@@ -904,29 +978,36 @@ signalVector *generateEdgeBurst(int tsc)
  * Pulse shaped bit sequences that go beyond one burst are truncated.
  * Pulse shaping at anything but 4 SPS is not supported.
  */
-signalVector *modulateEdgeBurst(const BitVector &bits,
-                                int sps, bool empty)
+bool modulateEdgeBurst(const BitVector &bits, int sps, signalVector &out,
+                       SigProcWorkspace &ws, bool empty)
 {
-  signalVector *shape, *burst;
-
   if ((sps != 4) && !empty)
-    return NULL;
+    return false;
 
-  burst = mapEdgeSymbols(bits);
-  if (!burst)
-    return NULL;
+  if (bits.size() % 3)
+    return false;
 
   if (empty)
-    shape = rotateEdgeBurst(*burst, sps);
+    return rotateEdgeBurst(bits, sps, out);
   else
-    shape = shapeEdgeBurst(*burst);
+    return shapeEdgeBurst(bits, out, ws);
+}
+
+signalVector *modulateEdgeBurst(const BitVector &bits,
+                                int sps, bool empty)
+{
+  signalVector *out = new signalVector(0, convolve_h_alloc, free);
+
+  if (!modulateEdgeBurst(bits, sps, *out, threadWorkspace(), empty)) {
+    delete out;
+    return NULL;
+  }
 
-  delete burst;
-  return shape;
+  return out;
 }
 
-static signalVector *modulateBurstBasic(const BitVector &bits,
-					int guard_len, int sps)
+static bool modulateBurstBasic(const BitVector &bits, int guard_len, int sps,
+                               signalVector &out, SigProcWorkspace &ws)
 {
   int burst_len;
   signalVector *pulse;
@@ -939,7 +1020,8 @@ static signalVector *modulateBurstBasic(const BitVector &bits,
 
   burst_len = sps * (bits.size() + guard_len);
 
-  signalVector burst(burst_len, pulse->size());
+  signalVector burst(reserveZeroed(ws.c0, pulse->size() + burst_len),
+                     pulse->size(), burst_len, NULL, keepBuffer);
   burst.isReal(true);
   burst_itr = burst.begin();
 
@@ -953,19 +1035,34 @@ static signalVector *modulateBurstBasic(const BitVector &bits,
   burst.isReal(false);
 
   /* Single Gaussian pulse approximation shaping */
-  return convolve(&burst, pulse, NULL, START_ONLY);
+  resizeVector(out, burst_len);
+  return convolve(&burst, pulse, &out, START_ONLY) != NULL;
 }
 
 /* Assume input bits are not differentially encoded */
-signalVector *modulateBurst(const BitVector &wBurst, int guardPeriodLength,
-			    int sps, bool emptyPulse)
+bool modulateBurst(const BitVector &wBurst, int guardPeriodLength, int sps,
+                   signalVector &out, SigProcWorkspace &ws, bool emptyPulse)
 {
   if (emptyPulse)
-    return rotateBurst(wBurst, guardPeriodLength, sps);
+    return rotateBurst(wBurst, guardPeriodLength, sps, out);
   else if (sps == 4)
-    return modulateBurstLaurent(wBurst);
+    return modulateBurstLaurent(wBurst, out, ws);
   else
-    return modulateBurstBasic(wBurst, guardPeriodLength, sps);
+    return modulateBurstBasic(wBurst, guardPeriodLength, sps, out, ws);
+}
+
+signalVector *modulateBurst(const BitVector &wBurst, int guardPeriodLength,
+			    int sps, bool emptyPulse)
+{
+  signalVector *out = new signalVector(0, convolve_h_alloc, free);
+
+  if (!modulateBurst(wBurst, guardPeriodLength, sps, *out,
+                     threadWorkspace(), emptyPulse)) {
+    delete out;
+    return NULL;
+  }
+
+  return out;
 }
 
 static void generateSincTable()
@@ -1033,6 +1130,58 @@ static void generateDelayFilters()
   }
 }
 
+/*
+ * Create sub-sample peak interpolation filterbank. Filter k evaluates the
+ * truncated sinc interpolant, spanning 8 samples either side, at an offset
+ * of k / PEAKFILTS past an integer sample from the PEAKFILT_LEN inputs
+ * surrounding it.
+ */
+static void generatePeakFilters()
+{
+  complex *data;
+  signalVector *h;
+  float d;
+
+  for (int k = 0; k < PEAKFILTS; k++) {
+    data = (complex *) convolve_h_alloc(PEAKFILT_LEN);
+    h = new signalVector(data, 0, PEAKFILT_LEN, convolve_h_alloc, free);
+    h->setAligned(true);
+    h->isReal(true);
+
+    for (int n = 0; n < PEAKFILT_LEN; n++) {
+      d = (float) (n - (PEAKFILT_LEN / 2 - 1)) - (float) k / PEAKFILTS;
+      (*h)[n] = sinc(M_PI_F * d);
+    }
+
+    peakFilters[k] = h;
+  }
+}
+
+/* Shift a vector by whole samples in place, zero filling the vacated span */
+static void shiftVector(signalVector &x, int whole)
+{
+  if (whole < 0) {
+    whole = -whole;
+    signalVector::iterator wBurstItr = x.begin();
+    signalVector::iterator shiftedItr = x.begin() + whole;
+
+    while (shiftedItr < x.end())
+      *wBurstItr++ = *shiftedItr++;
+
+    while (wBurstItr < x.end())
+      *wBurstItr++ = 0.0;
+  } else if (whole >= 0) {
+    signalVector::iterator wBurstItr = x.end() - 1;
+    signalVector::iterator shiftedItr = x.end() - 1 - whole;
+
+    while (shiftedItr >= x.begin())
+      *wBurstItr-- = *shiftedItr--;
+
+    while (wBurstItr >= x.begin())
+      *wBurstItr-- = 0.0;
+  }
+}
+
 signalVector *delayVector(const signalVector *in, signalVector *out, float delay)
 {
   int whole, index;
@@ -1058,26 +1207,7 @@ signalVector *delayVector(const signalVector *in, signalVector *out, float delay
     shift = fshift;
 
   /* Integer sample shift */
-  if (whole < 0) {
-    whole = -whole;
-    signalVector::iterator wBurstItr = shift->begin();
-    signalVector::iterator shiftedItr = shift->begin() + whole;
-
-    while (shiftedItr < shift->end())
-      *wBurstItr++ = *shiftedItr++;
-
-    while (wBurstItr < shift->end())
-      *wBurstItr++ = 0.0;
-  } else if (whole >= 0) {
-    signalVector::iterator wBurstItr = shift->end() - 1;
-    signalVector::iterator shiftedItr = shift->end() - 1 - whole;
-
-    while (shiftedItr >= shift->begin())
-      *wBurstItr-- = *shiftedItr--;
-
-    while (wBurstItr >= shift->begin())
-      *wBurstItr-- = 0.0;
-  }
+  shiftVector(*shift, whole);
 
   if (!out)
     return shift;
@@ -1087,70 +1217,88 @@ signalVector *delayVector(const signalVector *in, signalVector *out, float delay
   return out;
 }
 
-static complex interpolatePoint(const signalVector &inSig, float ix)
+/* Same as delayVector() into out, resized to the input length if needed */
+static bool delayBurst(const signalVector &in, float delay, signalVector &out,
+                       SigProcWorkspace &ws)
 {
-  int start = (int) (floor(ix) - 10);
-  if (start < 0) start = 0;
-  int end = (int) (floor(ix) + 11);
-  if ((unsigned) end > inSig.size()-1) end = inSig.size()-1;
+  int whole = floor(delay);
+  float frac = delay - whole;
 
-  complex pVal = 0.0;
-  if (!inSig.isReal()) {
-    for (int i = start; i < end; i++)
-      pVal += inSig[i] * sinc(M_PI_F*(i-ix));
+  resizeVector(out, in.size());
+
+  if (fabs(frac) > 1e-2) {
+    signalVector *h = delayFilters[(int) floorf(frac * (float) DELAYFILTS)];
+
+    if (!convolve(&in, h, &out, NO_DELAY, 0, 0, &ws.window))
+      return false;
+  } else {
+    std::copy(in.begin(), in.end(), out.begin());
   }
-  else {
-    for (int i = start; i < end; i++)
-      pVal += inSig[i].real() * sinc(M_PI_F*(i-ix));
+
+  shiftVector(out, whole);
+
+  return true;
+}
+
+/*
+ * Interpolate a point at a position given in units of 1/PEAKFILTS samples.
+ * Away from the vector edges this is a single vectorized dot product.
+ */
+static complex interpolatePoint(const signalVector &inSig, int pos)
+{
+  int whole = pos >= 0 ? pos / PEAKFILTS : -((PEAKFILTS - 1 - pos) / PEAKFILTS);
+  int head = whole - (PEAKFILT_LEN / 2 - 1);
+  signalVector *h = peakFilters[pos - whole * PEAKFILTS];
+  complex pVal = 0.0;
+
+  if ((head >= 0) && (head + PEAKFILT_LEN <= (int) inSig.size())) {
+    convolve_real((float *) inSig.begin(), inSig.size(),
+                  (float *) h->begin(), PEAKFILT_LEN,
+                  (float *) &pVal, 1,
+                  head + PEAKFILT_LEN - 1, 1);
+  } else {
+    for (int i = 0; i < PEAKFILT_LEN; i++) {
+      if ((head + i >= 0) && (head + i < (int) inSig.size()))
+        pVal += inSig[head + i] * (*h)[i].real();
+    }
   }
 
+  if (inSig.isReal())
+    pVal = pVal.real();
+
   return pVal;
 }
 
 static complex fastPeakDetect(const signalVector &rxBurst, float *index)
 {
-  float val, max = 0.0f;
-  complex amp;
-  int _index = -1;
+  float max;
+  int _index;
 
-  for (size_t i = 0; i < rxBurst.size(); i++) {
-    val = rxBurst[i].norm2();
-    if (val > max) {
-      max = val;
-      _index = i;
-      amp = rxBurst[i];
-    }
-  }
+  _index = argmax_norm2((const float *) rxBurst.begin(), rxBurst.size(), &max);
 
   if (index)
     *index = (float) _index;
 
-  return amp;
+  return _index < 0 ? complex(0.0f) : rxBurst[_index];
 }
 
 static complex peakDetect(const signalVector &rxBurst,
                           float *peakIndex, float *avgPwr)
 {
-  complex maxVal = 0.0;
-  float maxIndex = -1;
-  float sumPower = 0.0;
+  complex maxVal;
+  int maxIndex;
+  float maxPower;
 
-  for (unsigned int i = 0; i < rxBurst.size(); i++) {
-    float samplePower = rxBurst[i].norm2();
-    if (samplePower > maxVal.real()) {
-      maxVal = samplePower;
-      maxIndex = i;
-    }
-    sumPower += samplePower;
-  }
+  maxIndex = argmax_norm2((const float *) rxBurst.begin(), rxBurst.size(),
+                          &maxPower);
 
   // interpolate around the peak
-  // to save computation, we'll use early-late balancing
-  float earlyIndex = maxIndex-1;
-  float lateIndex = maxIndex+1;
+  // to save computation, we'll use early-late balancing on the
+  // 1/PEAKFILTS sample grid of the interpolation filterbank
+  int earlyIndex = (maxIndex - 1) * PEAKFILTS;
+  int lateIndex = earlyIndex + 2 * PEAKFILTS;
 
-  float incr = 0.5;
-  while (incr > 1.0/1024.0) {
+  for (int incr = PEAKFILTS / 2; incr > 0; incr /= 2) {
     complex earlyP = interpolatePoint(rxBurst,earlyIndex);
     complex lateP =  interpolatePoint(rxBurst,lateIndex);
     if (earlyP < lateP)
@@ -1158,18 +1306,17 @@ static complex peakDetect(const signalVector &rxBurst,
     else if (earlyP > lateP)
       earlyIndex -= incr;
     else break;
-    incr /= 2.0;
-    lateIndex = earlyIndex + 2.0;
+    lateIndex = earlyIndex + 2 * PEAKFILTS;
   }
 
-  maxIndex = earlyIndex + 1.0;
+  maxIndex = earlyIndex + PEAKFILTS;
   maxVal = interpolatePoint(rxBurst,maxIndex);
 
   if (peakIndex!=NULL)
-    *peakIndex = maxIndex;
+    *peakIndex = (float) maxIndex / PEAKFILTS;
 
   if (avgPwr!=NULL)
-    *avgPwr = (sumPower-maxVal.norm2()) / (rxBurst.size()-1);
+    *avgPwr = (vectorNorm2(rxBurst)-maxVal.norm2()) / (rxBurst.size()-1);
 
   return maxVal;
 
@@ -1178,28 +1325,9 @@ static complex peakDetect(const signalVector &rxBurst,
 void scaleVector(signalVector &x,
 		 complex scale)
 {
-#ifdef HAVE_NEON
-  int len = x.size();
-
   scale_complex((float *) x.begin(),
                 (float *) x.begin(),
-                (float *) &scale, len);
-#else
-  signalVector::iterator xP = x.begin();
-  signalVector::iterator xPEnd = x.end();
-  if (!x.isReal()) {
-    while (xP < xPEnd) {
-      *xP = *xP * scale;
-      xP++;
-    }
-  }
-  else {
-    while (xP < xPEnd) {
-      *xP = xP->real() * scale;
-      xP++;
-    }
-  }
-#endif
+                (float *) &scale, x.size());
 }
 
 /** in-place conjugation */
@@ -1426,34 +1554,196 @@ static float computePeakRatio(signalVector *corr,
   return (amp.abs()) / rms;
 }
 
-float energyDetect(const signalVector &rxBurst, unsigned windowLength)
+float energyDetect(const signalVector &rxBurst, unsigned windowLength,
+                   float *max_ampl)
 {
+  float energy, peak;
 
-  signalVector::const_iterator windowItr = rxBurst.begin(); //+rxBurst.size()/2 - 5*windowLength/2;
-  float energy = 0.0;
-  if (windowLength == 0) return 0.0;
   if (windowLength > rxBurst.size()) windowLength = rxBurst.size();
-  for (unsigned i = 0; i < windowLength; i++) {
-    energy += windowItr->norm2();
-    windowItr+=4;
-  }
-  return energy/windowLength;
-}
 
-static signalVector *downsampleBurst(const signalVector &burst)
-{
-  signalVector in(DOWNSAMPLE_IN_LEN, dnsampler->len());
-  signalVector *out = new signalVector(DOWNSAMPLE_OUT_LEN);
-  burst.copyToSegment(in, 0, DOWNSAMPLE_IN_LEN);
+  /* Single pass for the energy window and the clipping peak */
+  burst_stats((const float *) rxBurst.begin(), rxBurst.size(),
+              windowLength, &energy, &peak);
 
-  if (dnsampler->rotate((float *) in.begin(), DOWNSAMPLE_IN_LEN,
-                        (float *) out->begin(), DOWNSAMPLE_OUT_LEN) < 0) {
-    delete out;
-    out = NULL;
+  if (max_ampl)
+    *max_ampl = peak;
+
+  if (windowLength == 0) return 0.0;
+  return energy/windowLength;
+}
+
+/*
+ * Downsample symbols lo to hi (exclusive) of a 4 SPS burst into the same
+ * positions of a 1 SPS burst. The filter history of the first symbol is
+ * taken from the preceding samples of the burst, so any window yields the
+ * same symbols as downsampling the whole burst.
+ */
+static bool downsampleWindow(const signalVector &burst, signalVector &out,
+                             int lo, int hi, SigProcWorkspace &ws)
+{
+  int hist = dnsampler->len(), first;
+  complex *data;
+
+  lo = std::max(lo, 0);
+  hi = std::min(hi, DOWNSAMPLE_OUT_LEN);
+  if (hi <= lo)
+    return true;
+
+  data = reserveBuffer(ws.window, hist + 4 * (hi - lo));
+  signalVector in(data, hist, 4 * (hi - lo), NULL, keepBuffer);
+  first = std::max(4 * lo - hist, 0);
+  std::fill(in.begin() - hist, in.begin() + first - 4 * lo, complex(0.0f));
+  std::copy(burst.begin() + first, burst.begin() + 4 * hi,
+            in.begin() + first - 4 * lo);
+
+  return dnsampler->rotate((float *) in.begin(), 4 * (hi - lo),
+                           (float *) (out.begin() + lo), hi - lo) >= 0;
+}
+
+/*
+ * Convolve each fractional delay filter with the downsampler taps. Taps are
+ * real and stored in reverse like the filter partitions of the resampler,
+ * zero padded at the front to a multiple of four taps. The last filter holds
+ * the downsampler alone for integer sample delays.
+ */
+static bool generateDemodFilters()
+{
+  const std::complex<float> *dn = dnsampler->taps(0);
+  int dlen = dnsampler->len(), hlen = delayFilters[0]->size();
+  int pad = DEMODFILT_LEN - (dlen + hlen - 1), mid = hlen - 1 - hlen / 2;
+
+  if (!dn || (pad < 0))
+    return false;
+
+  demodFilters = (complex *) convolve_h_alloc((DELAYFILTS + 1) *
+                                              DEMODFILT_LEN);
+
+  for (int i = 0; i <= DELAYFILTS; i++) {
+    complex *g = demodFilters + i * DEMODFILT_LEN;
+
+    std::fill(g, g + DEMODFILT_LEN, complex(0.0f));
+    for (int k = 0; k < hlen; k++) {
+      float h;
+
+      if (i < DELAYFILTS)
+        h = (*delayFilters[i])[k].real();
+      else
+        h = k == mid ? 1.0f : 0.0f;
+
+      for (int j = 0; j < dlen; j++)
+        g[pad + j + k] += dn[j].real() * h;
+    }
   }
 
-  return out;
-};
+  /* Input sample of the first tap for output symbol n, less 4 * n */
+  demodOffset = pad + (dlen - 1) + mid;
+
+  for (int n = 0; n < DOWNSAMPLE_OUT_LEN; n++) {
+    demodIndex[n] = 4 * n + DEMODFILT_LEN - 1;
+    demodPath[n] = 0;
+  }
+
+  return true;
+}
+
+/*
+ * Delay and downsample a single symbol in two stages like delayVector()
+ * followed by the downsampler. The delayed burst is cut to samples lo to hi
+ * (exclusive), which the combined filter cannot account for.
+ */
+static complex delayDownsampleSymbol(const signalVector &burst,
+                                     const signalVector *h, int whole,
+                                     int lo, int hi, int n)
+{
+  const std::complex<float> *dn = dnsampler->taps(0);
+  int dlen = dnsampler->len(), size = burst.size();
+  complex sum = 0.0f;
+
+  for (int j = 0; j < dlen; j++) {
+    int m = 4 * n - (dlen - 1) + j;
+    complex z = 0.0f;
+
+    if ((m < lo) || (m >= hi))
+      continue;
+
+    if (!h) {
+      z = burst[m - whole];
+    } else {
+      int hlen = h->size(), i = m - whole - (hlen - 1 - hlen / 2);
+
+      for (int k = 0; k < hlen; k++) {
+        if ((i + k >= 0) && (i + k < size))
+          z += burst[i + k] * (*h)[k].real();
+      }
+    }
+
+    sum += z * dn[j].real();
+  }
+
+  return sum;
+}
+
+/*
+ * Fractional delay and downsampling of a 4 SPS burst in one polyphase pass
+ * over the burst shifted by the integer delay. Matches delayVector()
+ * followed by the downsampler, where the symbols near the edges of the
+ * shifted burst are computed in two stages. Unlike delayVector(), the
+ * samples ahead of an advanced burst are kept as filter history, so that
+ * its first symbols are not distorted by a cut through their pulses.
+ */
+static bool delayDownsampleBurst(const signalVector &burst, float delay,
+                                 signalVector &dec, SigProcWorkspace &ws)
+{
+  int whole = floor(delay), index = DELAYFILTS, size = burst.size();
+  int lo, hi, nlo, nhi, base, first, last, rc;
+  float frac = delay - whole;
+  const signalVector *h = NULL;
+
+  /* Same fractional threshold as delayVector() */
+  if (fabs(frac) > 1e-2) {
+    index = floorf(frac * (float) DELAYFILTS);
+    h = delayFilters[index];
+  }
+
+  /* Span of the delayed burst and the symbols that lie fully within it */
+  lo = whole > 0 ? whole : -(int) dnsampler->len();
+  hi = std::min(size, size + whole);
+  nlo = std::min((lo + (int) dnsampler->len() + 2) / 4, DOWNSAMPLE_OUT_LEN);
+  nhi = std::max(std::min((hi + 3) / 4, DOWNSAMPLE_OUT_LEN), nlo);
+
+  resizeVector(dec, DOWNSAMPLE_OUT_LEN);
+
+  if (nhi > nlo) {
+    size_t in_len = DOWNSAMPLE_IN_LEN + DEMODFILT_LEN - 4;
+    signalVector in(reserveZeroed(ws.window, in_len), 0, in_len,
+                    NULL, keepBuffer);
+
+    base = -whole - demodOffset;
+    first = std::max(base, 0);
+    last = std::min(base + (int) in.size(), size);
+    if (last > first)
+      std::copy(burst.begin() + first, burst.begin() + last,
+                in.begin() + first - base);
+
+    rc = convolve_real_polyphase((float *) in.begin(), in.size(),
+                                 (float *) (demodFilters +
+                                            index * DEMODFILT_LEN),
+                                 DEMODFILT_LEN,
+                                 (float *) (dec.begin() + nlo),
+                                 DOWNSAMPLE_OUT_LEN - nlo,
+                                 &demodIndex[nlo], &demodPath[nlo],
+                                 nhi - nlo);
+    if (rc < 0)
+      return false;
+  }
+
+  for (int n = 0; n < nlo; n++)
+    dec[n] = delayDownsampleSymbol(burst, h, whole, lo, hi, n);
+  for (int n = nhi; n < DOWNSAMPLE_OUT_LEN; n++)
+    dec[n] = delayDownsampleSymbol(burst, h, whole, lo, hi, n);
+
+  return true;
+}
 
 /*
  * Computes C/I (Carrier-to-Interference ratio) in dB (deciBels).
@@ -1483,60 +1773,159 @@ static float computeCI(const signalVector *burst, CorrelationSequence *sync,
 }
 
 /*
- * Detect a burst based on correlation and peak-to-average ratio
- *
- * For one sampler-per-symbol, perform fast peak detection (no interpolation)
- * for initial gating. We do this because energy detection should be disabled.
- * For higher oversampling values, we assume the energy detector is in place
- * and we run full interpolating peak detection.
+ * Split xLen samples of the input starting at base into real and imaginary
+ * parts, zero filled where the window extends past either end of the input
  */
-static int detectBurst(const signalVector &burst,
-                       signalVector &corr, CorrelationSequence *sync,
-                       float thresh, int sps, int start, int len,
-                       struct estim_burst_params *ebp)
+static void loadWindow(const signalVector &x, ssize_t base, ssize_t xLen,
+                       float *x_re, float *x_im)
 {
-  const signalVector *corr_in;
-  signalVector *dec = NULL;
-  complex xcorr;
-  int rc = 1;
+  ssize_t lo = std::max(base, (ssize_t) 0);
+  ssize_t hi = std::min(base + xLen, (ssize_t) x.size());
 
-  if (sps == 4) {
-    dec = downsampleBurst(burst);
-    corr_in = dec;
-    sps = 1;
-  } else {
-    corr_in = &burst;
+  if (hi <= lo) {
+    lo = base;
+    hi = base;
   }
 
-  /* Correlate */
-  if (!convolve(corr_in, sync->sequence, &corr,
-                CUSTOM, start, len)) {
-    rc = -1;
-    goto del_ret;
+  memset(x_re, 0, (lo - base) * sizeof(float));
+  memset(x_im, 0, (lo - base) * sizeof(float));
+  convert_float_planar(&x_re[lo - base], &x_im[lo - base],
+                       (const float *) (x.begin() + lo), hi - lo);
+  memset(&x_re[hi - base], 0, (base + xLen - hi) * sizeof(float));
+  memset(&x_im[hi - base], 0, (base + xLen - hi) * sizeof(float));
+}
+
+/*
+ * Direct correlation on split I/Q buffers. The search window is deinterleaved
+ * once, zero filled outside of the burst as with the CUSTOM convolve span,
+ * so that each tap is a broadcast multiply-accumulate over consecutive
+ * outputs without lane shuffles. Sequences without a planar copy fall back
+ * to the interleaved convolution.
+ */
+static bool correlateDirect(const signalVector &x, CorrelationSequence *sync,
+                            signalVector &y, size_t start, size_t len,
+                            SigProcWorkspace &ws)
+{
+
+  if (sync->planar.empty())
+    return convolve(&x, sync->sequence, &y, CUSTOM, start, len, &ws.window);
+
+  if (len > y.size())
+    return false;
+
+  ssize_t hLen = sync->sequence->size();
+  ssize_t xLen = len + hLen - 1;
+
+  ws.planar.resize(2 * xLen + 2 * len);
+  float *x_re = &ws.planar[0];
+  float *x_im = x_re + xLen;
+  float *y_re = x_im + xLen;
+  float *y_im = y_re + len;
+
+  loadWindow(x, (ssize_t) start - (hLen - 1), xLen, x_re, x_im);
+
+  if (convolve_complex_planar(x_re, x_im, xLen,
+                              &sync->planar[0], &sync->planar[hLen], hLen,
+                              y_re, y_im, len, hLen - 1, len) < 0)
+    return false;
+
+  convert_planar_float((float *) y.begin(), y_re, y_im, len);
+
+  return true;
+}
+
+/*
+ * Correlate the input against num sequences of hLen taps each in a single
+ * pass. Each window load is shared by all sequences. Taps are laid out as
+ * in gRACHPlanar. Correlation k is returned in the split I/Q scratch at
+ * offset k * len, the imaginary parts following at num * len.
+ */
+static float *correlateMulti(const signalVector &x, const float *taps,
+                             size_t hLen, int num, size_t start, size_t len,
+                             SigProcWorkspace &ws)
+{
+  ssize_t xLen = len + hLen - 1;
+
+  ws.multi.resize(2 * xLen + 2 * num * len);
+  float *x_re = &ws.multi[0];
+  float *x_im = x_re + xLen;
+  float *y_re = x_im + xLen;
+  float *y_im = y_re + num * len;
+
+  loadWindow(x, (ssize_t) start - (hLen - 1), xLen, x_re, x_im);
+
+  if (convolve_complex_planar_multi(x_re, x_im, xLen,
+                                    taps, &taps[num * hLen], hLen, num,
+                                    y_re, y_im, len, hLen - 1, len) < 0)
+    return NULL;
+
+  return y_re;
+}
+
+/*
+ * Use the multi-sequence correlator for this set of sequences and window,
+ * unless split taps are missing or a sequence is better served by the
+ * frequency domain path
+ */
+static bool useMulti(CorrelationSequence **syncs, int num, const float *taps,
+                     size_t len)
+{
+  if (!taps || (num < 2))
+    return false;
+
+  for (int i = 0; i < num; i++) {
+    if (syncs[i]->fft && (len >= syncs[i]->fftMinLen))
+      return false;
   }
 
-  /* Running at the downsampled rate at this point */
-  sps = 1;
+  return true;
+}
+
+/*
+ * Correlate a burst at one sample-per-symbol with a single sequence. Wide
+ * search windows are cheaper in the frequency domain.
+ */
+static bool correlateBurst(const signalVector &x, CorrelationSequence *sync,
+                           signalVector &corr, int start, int len,
+                           SigProcWorkspace &ws)
+{
+  if (sync->fft && ((size_t) len >= sync->fftMinLen))
+    return sync->fft->correlate(x, corr, start, len);
+
+  return correlateDirect(x, sync, corr, start, len, ws);
+}
+
+/*
+ * Peak detection on the correlation of a burst at one sample-per-symbol.
+ * Returns 1 if the peak-to-average ratio passes the threshold, 0 otherwise,
+ * with the ratio stored either way.
+ */
+static int evaluateBurst(const signalVector &burst, signalVector &corr,
+                         CorrelationSequence *sync, float thresh,
+                         int start, int len,
+                         struct estim_burst_params *ebp, float *ratio)
+{
+  complex xcorr;
+  int sps = 1;
+
+  *ratio = 0.0f;
 
   /* Peak detection - place restrictions at correlation edges */
   ebp->amp = fastPeakDetect(corr, &ebp->toa);
 
-  if ((ebp->toa < 3 * sps) || (ebp->toa > len - 3 * sps)) {
-    rc = 0;
-    goto del_ret;
-  }
+  if ((ebp->toa < 3 * sps) || (ebp->toa > len - 3 * sps))
+    return 0;
 
   /* Peak-to-average ratio */
-  if (computePeakRatio(&corr, sps, ebp->toa, ebp->amp) < thresh) {
-    rc = 0;
-    goto del_ret;
-  }
+  *ratio = computePeakRatio(&corr, sps, ebp->toa, ebp->amp);
+  if (*ratio < thresh)
+    return 0;
 
   /* Refine TOA and correlation value */
   xcorr = peakDetect(corr, &ebp->toa, NULL);
 
   /* Compute C/I */
-  ebp->ci = computeCI(corr_in, sync, ebp->toa, start, xcorr);
+  ebp->ci = computeCI(&burst, sync, ebp->toa, start, xcorr);
 
   /* Normalize our channel gain */
   ebp->amp = xcorr / sync->gain;
@@ -1544,22 +1933,110 @@ static int detectBurst(const signalVector &burst,
   /* Compensate for residuate time lag */
   ebp->toa = ebp->toa - sync->toa;
 
-del_ret:
-  delete dec;
+  return 1;
+}
+
+/*
+ * Detect a burst based on correlation and peak-to-average ratio
+ *
+ * The burst is downsampled once and correlated with each of the candidate
+ * sequences, in a single pass when their split taps are given. If more than
+ * one passes the threshold, the one with the highest peak-to-average ratio
+ * is reported through idx, the first one on a tie. The ratio of every
+ * candidate is stored in ratios unless NULL.
+ *
+ * At 4 SPS, only the symbols read by the correlators are downsampled. The
+ * partial burst is kept in ctx for the demodulator, or in the workspace if
+ * ctx is NULL.
+ *
+ * For one sampler-per-symbol, perform fast peak detection (no interpolation)
+ * for initial gating. We do this because energy detection should be disabled.
+ * For higher oversampling values, we assume the energy detector is in place
+ * and we run full interpolating peak detection.
+ */
+static int detectBurst(const signalVector &burst,
+                       CorrelationSequence **syncs, int num,
+                       const float *taps, float thresh,
+                       int sps, int start, int len,
+                       struct estim_burst_params *ebp, int *idx,
+                       float *ratios, struct burst_ctx *ctx,
+                       SigProcWorkspace &ws)
+{
+  const signalVector *corr_in;
+  signalVector corr(reserveBuffer(ws.corr, len), 0, len, NULL, keepBuffer);
+  struct estim_burst_params est = *ebp;
+  float ratio, best = 0.0f;
+  const float *multi = NULL;
+  int found, lo, hi, hLen = 0;
+  int rc = 0;
+
+  if (sps == 4) {
+    for (int i = 0; i < num; i++)
+      hLen = std::max(hLen, (int) syncs[i]->sequence->size());
+
+    lo = std::max(start - (hLen - 1), 0);
+    hi = std::min(start + len, DOWNSAMPLE_OUT_LEN);
+
+    if (!ctx)
+      ctx = &ws.ctx;
+
+    ctx->sps = 0;
+    if (ctx->dec.size() != DOWNSAMPLE_OUT_LEN)
+      ctx->dec.resize(DOWNSAMPLE_OUT_LEN);
+    else
+      std::fill(ctx->dec.begin(), ctx->dec.end(), complex(0.0f));
+
+    if (!downsampleWindow(burst, ctx->dec, lo, hi, ws))
+      return -1;
+    corr_in = &ctx->dec;
+
+    ctx->sps = 4;
+    ctx->lo = lo;
+    ctx->hi = hi;
+  } else {
+    corr_in = &burst;
+  }
+
+  if (useMulti(syncs, num, taps, len)) {
+    multi = correlateMulti(*corr_in, taps, syncs[0]->sequence->size(), num,
+                           start, len, ws);
+    if (!multi)
+      return -1;
+  }
+
+  for (int i = 0; i < num; i++) {
+    if (multi) {
+      convert_planar_float((float *) corr.begin(), &multi[i * len],
+                           &multi[(num + i) * len], len);
+    } else if (!correlateBurst(*corr_in, syncs[i], corr, start, len, ws)) {
+      return -1;
+    }
+
+    found = evaluateBurst(*corr_in, corr, syncs[i], thresh, start, len,
+                          &est, &ratio);
+    if (ratios)
+      ratios[i] = ratio;
+    if (!found)
+      continue;
+
+    if (!rc || (ratio > best)) {
+      *ebp = est;
+      *idx = i;
+      best = ratio;
+      rc = 1;
+    }
+  }
+
   return rc;
 }
 
 static float maxAmplitude(const signalVector &burst)
 {
-    float max = 0.0;
-    for (size_t i = 0; i < burst.size(); i++) {
-        if (fabs(burst[i].real()) > max)
-            max = fabs(burst[i].real());
-        if (fabs(burst[i].imag()) > max)
-            max = fabs(burst[i].imag());
-    }
+  float energy, max;
 
-    return max;
+  burst_stats((const float *) burst.begin(), burst.size(), 0, &energy, &max);
+
+  return max;
 }
 
 /*
@@ -1572,8 +2049,11 @@ static float maxAmplitude(const signalVector &burst)
  */
 static int detectGeneralBurst(const signalVector &rxBurst, float thresh, int sps,
                               int target, int head, int tail,
-                              CorrelationSequence *sync,
-                              struct estim_burst_params *ebp)
+                              CorrelationSequence **syncs, int num,
+                              const float *taps,
+                              struct estim_burst_params *ebp, float maxAmpl,
+                              int *idx, float *ratios,
+                              struct burst_ctx *ctx, SigProcWorkspace &ws)
 {
   int rc, start, len;
   bool clipping = false;
@@ -1584,7 +2064,6 @@ static int detectGeneralBurst(const signalVector &rxBurst, float thresh, int sps
   // Detect potential clipping
   // We still may be able to demod the burst, so we'll give it a try
   // and only report clipping if we can't demod.
-  float maxAmpl = maxAmplitude(rxBurst);
   if (maxAmpl > CLIP_THRESH) {
     LOG(DEBUG) << "max burst amplitude: " << maxAmpl << " is above the clipping threshold: " << CLIP_THRESH << std::endl;
     clipping = true;
@@ -1592,10 +2071,9 @@ static int detectGeneralBurst(const signalVector &rxBurst, float thresh, int sps
 
   start = target - head - 1;
   len = head + tail;
-  signalVector corr(len);
 
-  rc = detectBurst(rxBurst, corr, sync,
-                   thresh, sps, start, len, ebp);
+  rc = detectBurst(rxBurst, syncs, num, taps,
+                   thresh, sps, start, len, ebp, idx, ratios, ctx, ws);
   if (rc < 0) {
     return -SIGERR_INTERNAL;
   } else if (!rc) {
@@ -1619,26 +2097,28 @@ static int detectGeneralBurst(const signalVector &rxBurst, float thresh, int sps
  *   target: Tail bits + RACH length (reduced from 41 to a multiple of 4)
  *   head: Search 8 symbols before target
  *   tail: Search 8 symbols + maximum expected delay
+ *
+ * With extended RACH, the synchronization sequences of all three training
+ * sequence sets are searched and the best match is reported.
  */
 static int detectRACHBurst(const signalVector &burst, float threshold, int sps,
-                           unsigned max_toa, bool ext, struct estim_burst_params *ebp)
+                           unsigned max_toa, bool ext, struct estim_burst_params *ebp,
+                           float max_ampl, struct burst_ctx *ctx,
+                           SigProcWorkspace &ws)
 {
   int rc, target, head, tail;
-  int i, num_seq;
+  int idx = 0, num_seq;
 
   target = 8 + 40;
   head = 8;
   tail = 8 + max_toa;
   num_seq = ext ? 3 : 1;
 
-  for (i = 0; i < num_seq; i++) {
-    rc = detectGeneralBurst(burst, threshold, sps, target, head, tail,
-                            gRACHSequences[i], ebp);
-    if (rc > 0) {
-      ebp->tsc = i;
-      break;
-    }
-  }
+  rc = detectGeneralBurst(burst, threshold, sps, target, head, tail,
+                          gRACHSequences, num_seq,
+                          gRACHPlanar.empty() ? NULL : &gRACHPlanar[0],
+                          ebp, max_ampl, &idx, NULL, ctx, ws);
+  ebp->tsc = idx;
 
   return rc;
 }
@@ -1648,33 +2128,43 @@ static int detectRACHBurst(const signalVector &burst, float threshold, int sps,
  *
  * Correlation window parameters:
  *   target: Tail + data + mid-midamble + 1/2 remaining midamblebits
- *   head: Search 6 symbols before target
- *   tail: Search 6 symbols + maximum expected delay
+ *   head: Search symbols before target, 6 for the full window
+ *   tail: Search symbols after target, 6 + maximum expected delay
  */
 static int analyzeTrafficBurst(const signalVector &burst, unsigned tsc, float threshold,
-                               int sps, unsigned max_toa, struct estim_burst_params *ebp)
+                               int sps, int head, int tail,
+                               struct estim_burst_params *ebp, float max_ampl,
+                               struct burst_ctx *ctx, SigProcWorkspace &ws)
 {
-  int rc, target, head, tail;
-  CorrelationSequence *sync;
+  int rc, target, idx;
 
   if (tsc > 7)
     return -SIGERR_UNSUPPORTED;
 
   target = 3 + 58 + 16 + 5;
-  head = 6;
-  tail = 6 + max_toa;
-  sync = gMidambles[tsc];
 
   ebp->tsc = tsc;
-  rc = detectGeneralBurst(burst, threshold, sps, target, head, tail, sync, ebp);
+  rc = detectGeneralBurst(burst, threshold, sps, target, head, tail,
+                          &gMidambles[tsc], 1, NULL, ebp, max_ampl, &idx,
+                          NULL, ctx, ws);
   return rc;
 }
 
-static int detectEdgeBurst(const signalVector &burst, unsigned tsc, float threshold,
-                           int sps, unsigned max_toa, struct estim_burst_params *ebp)
+/*
+ * Joint EDGE and GMSK normal burst detection
+ *
+ * Both midambles are correlated over the same window of a single downsampled
+ * burst. If both pass the threshold, the modulation with the higher
+ * peak-to-average ratio is reported. Otherwise the GMSK result is returned,
+ * as if the EDGE detection had failed first.
+ */
+static int detectMixedBurst(const signalVector &burst, unsigned tsc, float threshold,
+                            int sps, unsigned max_toa, struct estim_burst_params *ebp,
+                            float max_ampl, CorrType *type,
+                            struct burst_ctx *ctx, SigProcWorkspace &ws)
 {
-  int rc, target, head, tail;
-  CorrelationSequence *sync;
+  int rc, target, head, tail, idx = 0;
+  CorrelationSequence *syncs[2];
 
   if (tsc > 7)
     return -SIGERR_UNSUPPORTED;
@@ -1682,33 +2172,41 @@ static int detectEdgeBurst(const signalVector &burst, unsigned tsc, float thresh
   target = 3 + 58 + 16 + 5;
   head = 6;
   tail = 6 + max_toa;
-  sync = gEdgeMidambles[tsc];
+  syncs[0] = gMidambles[tsc];
+  syncs[1] = gEdgeMidambles[tsc];
 
+  rc = detectGeneralBurst(burst, threshold, sps, target, head, tail,
+                          syncs, 2, NULL, ebp, max_ampl, &idx, NULL, ctx, ws);
   ebp->tsc = tsc;
-  rc = detectGeneralBurst(burst, threshold, sps,
-                          target, head, tail, sync, ebp);
+  *type = (rc > 0 && idx == 1) ? EDGE : TSC;
+
   return rc;
 }
 
 int detectAnyBurst(const signalVector &burst, unsigned tsc, float threshold,
                    int sps, CorrType type, unsigned max_toa,
-                   struct estim_burst_params *ebp)
+                   struct estim_burst_params *ebp, float max_ampl,
+                   struct burst_ctx *ctx, SigProcWorkspace &ws)
 {
   int rc = 0;
 
+  /* Clipping peak, unless the caller already has it from energyDetect() */
+  if (max_ampl < 0.0f)
+    max_ampl = maxAmplitude(burst);
+
   switch (type) {
   case EDGE:
-    rc = detectEdgeBurst(burst, tsc, threshold, sps, max_toa, ebp);
-    if (rc > 0)
-      break;
-    else
-      type = TSC;
+    rc = detectMixedBurst(burst, tsc, threshold, sps, max_toa, ebp, max_ampl,
+                          &type, ctx, ws);
+    break;
   case TSC:
-    rc = analyzeTrafficBurst(burst, tsc, threshold, sps, max_toa, ebp);
+    rc = analyzeTrafficBurst(burst, tsc, threshold, sps, 6, 6 + max_toa, ebp,
+                             max_ampl, ctx, ws);
     break;
   case EXT_RACH:
   case RACH:
-    rc = detectRACHBurst(burst, threshold, sps, max_toa, type == EXT_RACH, ebp);
+    rc = detectRACHBurst(burst, threshold, sps, max_toa, type == EXT_RACH, ebp,
+                         max_ampl, ctx, ws);
     break;
   default:
     LOG(ERR) << "Invalid correlation type";
@@ -1720,168 +2218,722 @@ int detectAnyBurst(const signalVector &burst, unsigned tsc, float threshold,
   return rc;
 }
 
+int detectAnyBurst(const signalVector &burst, unsigned tsc, float threshold,
+                   int sps, CorrType type, unsigned max_toa,
+                   struct estim_burst_params *ebp, float max_ampl,
+                   struct burst_ctx *ctx)
+{
+  return detectAnyBurst(burst, tsc, threshold, sps, type, max_toa, ebp,
+                        max_ampl, ctx, threadWorkspace());
+}
+
 /*
- * Soft 8-PSK decoding using Manhattan distance metric
+ * Normal burst detection around an expected time-of-arrival
+ *
+ * The window is padded by half the peak interpolation filter on either side,
+ * so that a peak found within the margin is estimated exactly as with the
+ * full window. The window is clipped to the full window of detectAnyBurst()
+ * for max_toa. Anything else, including an expected time-of-arrival outside
+ * of the full window, is reported as a miss.
  */
-static SoftVector *softSliceEdgeBurst(signalVector &burst)
+int detectNormalBurst(const signalVector &burst, unsigned tsc, float threshold,
+                      int sps, float toa, unsigned margin, unsigned max_toa,
+                      struct estim_burst_params *ebp, float max_ampl,
+                      struct burst_ctx *ctx, SigProcWorkspace &ws)
 {
-  size_t nsyms = 148;
+  int rc, center = (int) roundf(toa);
+  int pad = margin + PEAKFILT_LEN / 2;
+  int full_head = 6, full_tail = 6 + max_toa;
 
-  if (burst.size() < nsyms)
-    return NULL;
+  if ((center < -full_head) || (center > (int) max_toa))
+    return SIGERR_NONE;
 
-  signalVector::iterator itr;
-  SoftVector *bits = new SoftVector(nsyms * 3);
+  if (max_ampl < 0.0f)
+    max_ampl = maxAmplitude(burst);
+
+  rc = analyzeTrafficBurst(burst, tsc, threshold, sps,
+                           std::min(pad - center, full_head),
+                           std::min(pad + center, full_tail),
+                           ebp, max_ampl, ctx, ws);
+  if (rc <= 0)
+    return rc;
 
   /*
-   * Bits 0 and 1 - First and second bits of the symbol respectively
+   * A peak beyond the margin may be a sidelobe of a burst outside of the
+   * window, e.g. from another mobile with different timing
    */
-  rotateBurst2(burst, -M_PI / 8.0);
-  itr = burst.begin();
-  for (size_t i = 0; i < nsyms; i++) {
-    (*bits)[3 * i + 0] = -itr->imag();
-    (*bits)[3 * i + 1] = itr->real();
-    itr++;
+  if ((fabsf(ebp->toa - toa) > margin) || (ebp->toa > max_toa))
+    return SIGERR_NONE;
+
+  return TSC;
+}
+
+int detectNormalBurst(const signalVector &burst, unsigned tsc, float threshold,
+                      int sps, float toa, unsigned margin, unsigned max_toa,
+                      struct estim_burst_params *ebp, float max_ampl,
+                      struct burst_ctx *ctx)
+{
+  return detectNormalBurst(burst, tsc, threshold, sps, toa, margin, max_toa,
+                           ebp, max_ampl, ctx, threadWorkspace());
+}
+
+/*
+ * Normal burst detection against a set of midambles
+ *
+ * The burst is downsampled once and the selected midambles are correlated
+ * over the window of analyzeTrafficBurst() in a single pass. Taps of a
+ * subset are gathered from the full split tap table.
+ */
+int detectTscBurst(const signalVector &burst, unsigned tsc_mask, float threshold,
+                   int sps, unsigned max_toa, struct estim_burst_params *ebp,
+                   float *ratios, float max_ampl)
+{
+  SigProcWorkspace &ws = threadWorkspace();
+  CorrelationSequence *syncs[8];
+  float found[8] = { 0.0f };
+  const float *taps = NULL;
+  int rc, num = 0, idx = 0, tscs[8];
+
+  tsc_mask &= 0xff;
+  if (!tsc_mask)
+    return -SIGERR_UNSUPPORTED;
+
+  for (int i = 0; i < 8; i++) {
+    if (tsc_mask & (1 << i)) {
+      tscs[num] = i;
+      syncs[num++] = gMidambles[i];
+    }
+    if (ratios)
+      ratios[i] = 0.0f;
+  }
+
+  if ((num == 8) && !gMidamblePlanar.empty()) {
+    taps = &gMidamblePlanar[0];
+  } else if (!gMidamblePlanar.empty()) {
+    size_t hLen = gMidambles[0]->sequence->size();
+
+    ws.taps.resize(2 * num * hLen);
+    for (int i = 0; i < num; i++) {
+      memcpy(&ws.taps[i * hLen], &gMidamblePlanar[tscs[i] * hLen],
+             hLen * sizeof(float));
+      memcpy(&ws.taps[(num + i) * hLen], &gMidamblePlanar[(8 + tscs[i]) * hLen],
+             hLen * sizeof(float));
+    }
+    taps = &ws.taps[0];
+  }
+
+  if (max_ampl < 0.0f)
+    max_ampl = maxAmplitude(burst);
+
+  rc = detectGeneralBurst(burst, threshold, sps, 3 + 58 + 16 + 5, 6, 6 + max_toa,
+                          syncs, num, taps, ebp, max_ampl, &idx, found, NULL,
+                          ws);
+
+  if (ratios) {
+    for (int i = 0; i < num; i++)
+      ratios[tscs[i]] = found[i];
+  }
+
+  if (rc <= 0)
+    return rc;
+
+  ebp->tsc = tscs[idx];
+
+  return TSC;
+}
+
+/*
+ * Normal burst detection on the bursts of a TDMA frame
+ *
+ * Same as analyzeTrafficBurst() with the full search window, but each stage
+ * runs over all bursts before the next one. The search windows of all bursts
+ * are packed back to back and correlated with the midamble in a single call
+ * of the planar kernel. The hLen - 1 outputs straddling two windows are
+ * discarded.
+ */
+int detectNormalBursts(const signalVector *const *bursts, size_t num,
+                       unsigned tsc, float threshold, int sps, unsigned max_toa,
+                       struct estim_burst_params *ebp, const float *max_ampl,
+                       struct burst_ctx *const *ctx, int *rc,
+                       SigProcWorkspace &ws)
+{
+  const signalVector *corr_in;
+  CorrelationSequence *sync;
+  float ratio, ampl, *x_re, *x_im, *y_re, *y_im;
+  int head = 6, tail = 6 + max_toa, target = 3 + 58 + 16 + 5;
+  int start = target - head - 1, len = head + tail;
+  int hLen, xLen, detected = 0;
+  bool packed;
+
+  if ((tsc > 7) || ((sps != 1) && (sps != 4))) {
+    for (size_t i = 0; i < num; i++)
+      rc[i] = -SIGERR_UNSUPPORTED;
+    return -SIGERR_UNSUPPORTED;
+  }
+
+  if (!num)
+    return 0;
+
+  if (!ctx) {
+    if (ws.batch.size() < num)
+      ws.batch.resize(num);
+    ws.batch_ctx.resize(num);
+    for (size_t i = 0; i < num; i++)
+      ws.batch_ctx[i] = &ws.batch[i];
+    ctx = &ws.batch_ctx[0];
+  }
+
+  sync = gMidambles[tsc];
+  hLen = sync->sequence->size();
+  xLen = len + hLen - 1;
+  signalVector corr(reserveBuffer(ws.corr, len), 0, len, NULL, keepBuffer);
+
+  /* Downsample the search windows */
+  for (size_t i = 0; i < num; i++) {
+    rc[i] = 0;
+    ebp[i].tsc = tsc;
+    ctx[i]->sps = 0;
+    if (sps != 4)
+      continue;
+
+    if (ctx[i]->dec.size() != DOWNSAMPLE_OUT_LEN)
+      ctx[i]->dec.resize(DOWNSAMPLE_OUT_LEN);
+    else
+      std::fill(ctx[i]->dec.begin(), ctx[i]->dec.end(), complex(0.0f));
+
+    ctx[i]->lo = std::max(start - (hLen - 1), 0);
+    ctx[i]->hi = std::min(start + len, DOWNSAMPLE_OUT_LEN);
+    if (!downsampleWindow(*bursts[i], ctx[i]->dec, ctx[i]->lo, ctx[i]->hi,
+                          ws))
+      rc[i] = -SIGERR_INTERNAL;
+    else
+      ctx[i]->sps = 4;
   }
 
   /*
-   * Bit 2 - Collapse symbols into quadrant 0 (positive X and Y).
-   * Decision area is then simplified to X=Y axis. Rotate again to
-   * place decision boundary on X-axis.
+   * Correlate all windows at once where the planar path would be used. At
+   * 1 SPS, the discarded outputs cost more than the single pass saves.
    */
-  itr = burst.begin();
-  for (size_t i = 0; i < burst.size(); i++) {
-    burst[i] = Complex<float>(fabs(itr->real()), fabs(itr->imag()));
-    itr++;
+  packed = (sps == 4) && !sync->planar.empty() &&
+           !(sync->fft && ((size_t) len >= sync->fftMinLen));
+  if (packed) {
+    ws.multi.resize(4 * num * xLen);
+    x_re = &ws.multi[0];
+    x_im = x_re + num * xLen;
+    y_re = x_im + num * xLen;
+    y_im = y_re + num * xLen;
+
+    for (size_t i = 0; i < num; i++) {
+      corr_in = sps == 4 ? &ctx[i]->dec : bursts[i];
+      loadWindow(*corr_in, start - (hLen - 1), xLen,
+                 &x_re[i * xLen], &x_im[i * xLen]);
+    }
+
+    if (convolve_complex_planar(x_re, x_im, num * xLen,
+                                &sync->planar[0], &sync->planar[hLen], hLen,
+                                y_re, y_im, num * xLen, hLen - 1,
+                                num * xLen - (hLen - 1)) < 0) {
+      for (size_t i = 0; i < num; i++)
+        rc[i] = -SIGERR_INTERNAL;
+      return -SIGERR_INTERNAL;
+    }
   }
 
-  rotateBurst2(burst, -M_PI / 4.0);
-  itr = burst.begin();
-  for (size_t i = 0; i < nsyms; i++) {
-    (*bits)[3 * i + 2] = -itr->imag();
-    itr++;
+  /* Peak detection and estimation */
+  for (size_t i = 0; i < num; i++) {
+    if (rc[i] < 0)
+      continue;
+
+    corr_in = sps == 4 ? &ctx[i]->dec : bursts[i];
+    if (packed) {
+      convert_planar_float((float *) corr.begin(), &y_re[i * xLen],
+                           &y_im[i * xLen], len);
+    } else if (!correlateBurst(*corr_in, sync, corr, start, len, ws)) {
+      rc[i] = -SIGERR_INTERNAL;
+      continue;
+    }
+
+    if (!evaluateBurst(*corr_in, corr, sync, threshold, start, len,
+                       &ebp[i], &ratio)) {
+      ebp[i].amp = 0.0f;
+      ebp[i].toa = 0.0f;
+      ebp[i].ci = 0.0f;
+      ampl = (max_ampl && (max_ampl[i] >= 0.0f)) ?
+             max_ampl[i] : maxAmplitude(*bursts[i]);
+      rc[i] = ampl > CLIP_THRESH ? -SIGERR_CLIP : SIGERR_NONE;
+      continue;
+    }
+
+    /* Subtract forward search bits from delay */
+    ebp[i].toa -= head;
+    rc[i] = TSC;
+    detected++;
   }
 
-  signalVector soft(bits->size());
-  for (size_t i = 0; i < bits->size(); i++)
-    soft[i] = (*bits)[i];
+  return detected;
+}
 
-  return bits;
+int detectNormalBursts(const signalVector *const *bursts, size_t num,
+                       unsigned tsc, float threshold, int sps, unsigned max_toa,
+                       struct estim_burst_params *ebp, const float *max_ampl,
+                       struct burst_ctx *const *ctx, int *rc)
+{
+  return detectNormalBursts(bursts, num, tsc, threshold, sps, max_toa, ebp,
+                            max_ampl, ctx, rc, threadWorkspace());
 }
 
 /*
- * Convert signalVector to SoftVector by taking real part of the signal.
+ * Soft 8-PSK decoding of the first nsyms symbols of a 1 SPS burst using
+ * Manhattan distance metric. Each symbol is equalized with the inverse C0
+ * pulse and derotated in a single pass, with the single tap channel
+ * correction folded into the derotation table.
  */
-static SoftVector *signalToSoftVector(signalVector *dec)
+static bool demapEdgeBurst(const signalVector &burst, complex gain,
+                           float *bits, size_t nsyms)
 {
-  SoftVector *bits = new SoftVector(dec->size());
+  const signalVector *h = GSMPulse4->c0_inv;
+  int hlen = h->size(), size = burst.size();
+  int offset = hlen - 1 - hlen / 2;
+  complex derot[16];
+
+  if (nsyms > burst.size())
+    return false;
+
+  for (int i = 0; i < 16; i++)
+    derot[i] = edgeDerotTable[i] * gain;
+
+  for (int i = 0; i < (int) nsyms; i++) {
+    complex eq = 0.0f, d;
 
-  SoftVector::iterator bit_itr = bits->begin();
-  signalVector::iterator burst_itr = dec->begin();
+    /* Equalize, with zeros outside of the burst like convolve() */
+    for (int k = 0; k < hlen; k++) {
+      int n = i - offset + k;
+      if ((n >= 0) && (n < size))
+        eq += burst[n] * (*h)[k].real();
+    }
+
+    /*
+     * Bits 0 and 1 - First and second bits of the symbol respectively.
+     * The -pi/8 decision rotation is part of the derotation.
+     */
+    d = eq * derot[i % 16];
+    bits[3 * i + 0] = -d.imag();
+    bits[3 * i + 1] = d.real();
 
-  for (; burst_itr < dec->end(); burst_itr++)
-    *bit_itr++ = burst_itr->real();
+    /*
+     * Bit 2 - Collapse symbol into quadrant 0 (positive X and Y).
+     * Decision area is then simplified to X=Y axis, which a rotation by
+     * -pi/4 places on the X-axis.
+     */
+    bits[3 * i + 2] = (fabsf(d.real()) - fabsf(d.imag())) * (float) M_SQRT1_2;
+  }
 
-  return bits;
+  return true;
 }
 
 /*
- * Shared portion of GMSK and EDGE demodulators consisting of timing
- * recovery and single tap channel correction. For 4 SPS (if activated),
- * the output is downsampled prior to the 1 SPS modulation specific
- * stages.
+ * Downsample the num output symbols starting at sample offset pos of a 4 SPS
+ * burst, which is zero outside of its bounds. Samples before pos are used as
+ * filter history.
  */
-static signalVector *demodCommon(const signalVector &burst, int sps,
-                                 complex chan, float toa)
+static bool downsampleBlock(const signalVector &burst, int pos,
+                            complex *out, int num, SigProcWorkspace &ws)
 {
-  signalVector *delay, *dec;
+  int hist = dnsampler->len();
+  signalVector in(reserveZeroed(ws.window, hist + 4 * num), hist, 4 * num,
+                  NULL, keepBuffer);
 
-  if ((sps != 1) && (sps != 4))
-    return NULL;
+  for (int i = -hist; i < 4 * num; i++) {
+    if ((pos + i >= 0) && (pos + i < (int) burst.size()))
+      in.begin()[i] = burst[pos + i];
+  }
+
+  return dnsampler->rotate((float *) in.begin(), 4 * num,
+                           (float *) out, num) >= 0;
+}
+
+/*
+ * Timing recovery on the burst downsampled by the detector. A delay of whole
+ * symbols needs no fractional delay filter and commutes with the
+ * downsampler, so the burst is shifted at 1 SPS instead of delaying and
+ * downsampling it again at 4 SPS. Only the symbols that an advance moves
+ * past the end of the detector output are downsampled anew. Returns false
+ * if the delay is not whole symbols.
+ */
+static bool reuseDownsampled(const signalVector &burst, struct burst_ctx *ctx,
+                             float toa, signalVector &dec,
+                             SigProcWorkspace &ws)
+{
+  float delay = -toa * 4.0f;
+  int whole = floor(delay), shift, n;
+  int edge = (dnsampler->len() - 1 + 3) / 4;
+  complex *tail;
+
+  /* Same fractional threshold as delayVector() */
+  if (!ctx || (ctx->sps != 4) || (fabs(delay - whole) > 1e-2) || (whole % 4))
+    return false;
+
+  shift = -whole / 4;
+  if (shift > DOWNSAMPLE_OUT_LEN - edge)
+    return false;
 
-  delay = delayVector(&burst, NULL, -toa * (float) sps);
-  scaleVector(*delay, (complex) 1.0 / chan);
+  /* Complete the symbols outside of the correlation window */
+  if (!downsampleWindow(burst, ctx->dec, 0, ctx->lo, ws) ||
+      !downsampleWindow(burst, ctx->dec, ctx->hi, DOWNSAMPLE_OUT_LEN, ws))
+    return false;
+
+  ctx->lo = 0;
+  ctx->hi = DOWNSAMPLE_OUT_LEN;
+
+  resizeVector(dec, DOWNSAMPLE_OUT_LEN);
+
+  /* Delaying the burst keeps the zero history of the downsampler */
+  if (shift <= 0) {
+    for (n = 0; n < DOWNSAMPLE_OUT_LEN; n++)
+      dec[n] = n >= -shift ? ctx->dec[n + shift] : 0.0f;
+    return true;
+  }
+
+  /*
+   * Advancing the burst keeps the samples preceding the first symbols as
+   * their filter history, and moves symbols past the end of the detector
+   * output into the burst
+   */
+  tail = reserveBuffer(ws.edge, edge);
+  if (!downsampleBlock(burst, 4 * DOWNSAMPLE_OUT_LEN, tail, edge, ws))
+    return false;
+
+  for (n = 0; n < DOWNSAMPLE_OUT_LEN - shift; n++)
+    dec[n] = ctx->dec[n + shift];
+  for (; n < DOWNSAMPLE_OUT_LEN; n++) {
+    int i = n + shift - DOWNSAMPLE_OUT_LEN;
+    dec[n] = i < edge ? tail[i] : 0.0f;
+  }
+
+  return true;
+}
 
+/*
+ * Shared portion of GMSK and EDGE demodulators consisting of timing
+ * recovery. For 4 SPS (if activated), the output is downsampled prior to
+ * the 1 SPS modulation specific stages, which also apply the single tap
+ * channel correction. The 1 SPS burst is held in the workspace.
+ */
+static const signalVector *demodCommon(const signalVector &burst, int sps,
+                                       float toa, struct burst_ctx *ctx,
+                                       SigProcWorkspace &ws)
+{
   if (sps == 1)
-    return delay;
+    return delayBurst(burst, -toa, ws.dec, ws) ? &ws.dec : NULL;
+  if (sps != 4)
+    return NULL;
+
+  if (reuseDownsampled(burst, ctx, toa, ws.dec, ws))
+    return &ws.dec;
 
-  dec = downsampleBurst(*delay);
+  if (!delayDownsampleBurst(burst, -toa * (float) sps, ws.dec, ws))
+    return NULL;
 
-  delete delay;
-  return dec;
+  return &ws.dec;
 }
 
 /*
  * Demodulate GSMK burst. Prior to symbol rotation, operate at
  * 4 SPS (if activated) to minimize distortion through the fractional
  * delay filters. Symbol rotation and after always operates at 1 SPS.
+ * Writes up to len soft bits and returns the number of bits written.
  */
-static SoftVector *demodGmskBurst(const signalVector &rxBurst,
-                                  int sps, complex channel, float TOA)
+static int demodGmskBurst(const signalVector &rxBurst,
+                          int sps, complex channel, float TOA,
+                          struct burst_ctx *ctx, float *bits, size_t len,
+                          SigProcWorkspace &ws)
 {
-  SoftVector *bits;
-  signalVector *dec;
+  const signalVector *dec;
 
-  dec = demodCommon(rxBurst, sps, channel, TOA);
+  dec = demodCommon(rxBurst, sps, TOA, ctx, ws);
   if (!dec)
-    return NULL;
+    return -SIGERR_UNSUPPORTED;
+
+  len = std::min(len, dec->size());
 
-  /* Shift up by a quarter of a frequency */
-  GMSKReverseRotate(*dec, 1);
-  /* Take real part of the signal */
-  bits = signalToSoftVector(dec);
-  delete dec;
+  /* Shift up by a quarter of a frequency and take the real part */
+  if (!GMSKReverseRotateSoft(*dec, (complex) 1.0 / channel, bits, len))
+    return -SIGERR_BOUNDS;
 
-  return bits;
+  return len;
 }
 
 /*
  * Demodulate an 8-PSK burst. Prior to symbol rotation, operate at
  * 4 SPS (if activated) to minimize distortion through the fractional
  * delay filters. Symbol rotation and after always operates at 1 SPS.
+ * Writes up to len soft bits and returns the number of bits written.
  *
  * Allow 1 SPS demodulation here, but note that other parts of the
  * transceiver restrict EDGE operatoin to 4 SPS - 8-PSK distortion
  * through the fractional delay filters at 1 SPS renders signal
  * nearly unrecoverable.
  */
-static SoftVector *demodEdgeBurst(const signalVector &burst,
-                                  int sps, complex chan, float toa)
+static int demodEdgeBurst(const signalVector &burst,
+                          int sps, complex chan, float toa,
+                          struct burst_ctx *ctx, float *bits, size_t len,
+                          SigProcWorkspace &ws)
 {
-  SoftVector *bits;
-  signalVector *dec, *rot, *eq;
+  const signalVector *dec;
+  size_t nsyms = std::min(len, (size_t) EDGE_BURST_NBITS) / 3;
 
-  dec = demodCommon(burst, sps, chan, toa);
+  dec = demodCommon(burst, sps, toa, ctx, ws);
   if (!dec)
+    return -SIGERR_UNSUPPORTED;
+
+  /* Equalize, derotate and soft slice */
+  if (!demapEdgeBurst(*dec, (complex) 1.0 / chan, bits, nsyms))
+    return -SIGERR_BOUNDS;
+
+  return 3 * nsyms;
+}
+
+static int demodSoftBits(const signalVector &burst, int sps, complex amp,
+                         float toa, CorrType type, struct burst_ctx *ctx,
+                         float *bits, size_t len, SigProcWorkspace &ws)
+{
+  if (type == EDGE)
+    return demodEdgeBurst(burst, sps, amp, toa, ctx, bits, len, ws);
+  else
+    return demodGmskBurst(burst, sps, amp, toa, ctx, bits, len, ws);
+}
+
+SoftVector *demodAnyBurst(const signalVector &burst, int sps, complex amp,
+                          float toa, CorrType type,
+                          struct burst_ctx *ctx)
+{
+  float bits[DEMOD_MAX_NBITS];
+  SoftVector *out;
+  int rc;
+
+  rc = demodSoftBits(burst, sps, amp, toa, type, ctx, bits, DEMOD_MAX_NBITS,
+                     threadWorkspace());
+  if (rc < 0)
     return NULL;
 
-  /* Equalize and derotate */
-  eq = convolve(dec, GSMPulse4->c0_inv, NULL, NO_DELAY);
-  rot = derotateEdgeBurst(*eq, 1);
+  out = new SoftVector(rc);
+  std::copy(bits, bits + rc, out->begin());
+
+  return out;
+}
 
-  /* Soft slice and normalize */
-  bits = softSliceEdgeBurst(*rot);
+int demodAnyBurst(const signalVector &burst, int sps, complex amp,
+                  float toa, CorrType type, unsigned char *soft,
+                  size_t len, struct burst_ctx *ctx, SigProcWorkspace &ws)
+{
+  float bits[DEMOD_MAX_NBITS];
+  int rc;
 
-  delete dec;
-  delete eq;
-  delete rot;
+  rc = demodSoftBits(burst, sps, amp, toa, type, ctx, bits,
+                     std::min(len, (size_t) DEMOD_MAX_NBITS), ws);
+  if (rc > 0)
+    convert_float_soft(soft, bits, rc);
 
-  return bits;
+  return rc;
 }
 
-SoftVector *demodAnyBurst(const signalVector &burst, int sps, complex amp,
-                          float toa, CorrType type)
+int demodAnyBurst(const signalVector &burst, int sps, complex amp,
+                  float toa, CorrType type, unsigned char *soft,
+                  size_t len, struct burst_ctx *ctx)
 {
-  if (type == EDGE)
-    return demodEdgeBurst(burst, sps, amp, toa);
+  return demodAnyBurst(burst, sps, amp, toa, type, soft, len, ctx,
+                       threadWorkspace());
+}
+
+/*
+ * Time a correlator run over a search window, returning the fastest
+ * of several runs in seconds.
+ */
+template <typename F>
+static double timeCorrelator(F run)
+{
+  double best = std::numeric_limits<double>::max();
+
+  for (int i = 0; i < XOVER_RUNS; i++) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 0; n < XOVER_REPS; n++)
+      run();
+    auto t1 = std::chrono::steady_clock::now();
+
+    best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+  }
+
+  return best;
+}
+
+/*
+ * Register the per burst filter shapes with the kernel autotuner. This runs
+ * before the correlator setup so that the interleaved, planar and FFT
+ * correlator comparisons below are made against the tuned kernels.
+ */
+static void tuneKernelShapes()
+{
+  size_t len1 = 157, len4 = 625;
+
+  kernelTunerShape(CONV_REAL, GSMPulse1->c0->size(), len1);
+  kernelTunerShape(CONV_REAL, GSMPulse4->c0->size(), len4);
+  if (GSMPulse4->c1)
+    kernelTunerShape(CONV_REAL, GSMPulse4->c1->size(), len4);
+  kernelTunerShape(CONV_REAL, delayFilters[0]->size(), len4);
+
+  for (int i = 0; i < 8; i++) {
+    kernelTunerShape(CONV_COMPLEX, gMidambles[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+    kernelTunerShape(CONV_PLANAR, gMidambles[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+    kernelTunerShape(CONV_COMPLEX, gEdgeMidambles[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+    kernelTunerShape(CONV_PLANAR, gEdgeMidambles[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+  }
+
+  for (int i = 0; i < 3; i++) {
+    kernelTunerShape(CONV_COMPLEX, gRACHSequences[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+    kernelTunerShape(CONV_PLANAR, gRACHSequences[i]->sequence->size(),
+                     PLANAR_XOVER_LEN);
+  }
+
+  kernelTunerShape(CONV_POLYPHASE, DEMODFILT_LEN, DOWNSAMPLE_OUT_LEN);
+
+  /* The radio interface registered its shapes before, write all at once */
+  kernelTunerSave();
+}
+
+/*
+ * Split the correlation sequence into real and imaginary taps and keep the
+ * planar copy if it correlates a typical search window faster than the
+ * interleaved kernels. Which one wins depends on the tap count and on the
+ * SIMD tier, e.g. the interleaved path has no vector kernel for odd lengths.
+ */
+static void initPlanarSequence(CorrelationSequence *sync)
+{
+  size_t len = PLANAR_XOVER_LEN;
+  size_t hLen = sync->sequence->size();
+  size_t start = hLen - 1;
+  signalVector x(start + len), y(len);
+  SigProcWorkspace ws;
+
+  for (size_t i = 0; i < x.size(); i++)
+    x[i] = complex(1.0f, -1.0f);
+
+  sync->planar.clear();
+  double interleaved = timeCorrelator([&] {
+    correlateDirect(x, sync, y, start, len, ws);
+  });
+
+  sync->planar.resize(2 * hLen);
+  convert_float_planar(&sync->planar[0], &sync->planar[hLen],
+                       (const float *) sync->sequence->begin(), hLen);
+  double planar = timeCorrelator([&] {
+    correlateDirect(x, sync, y, start, len, ws);
+  });
+
+  if (planar >= interleaved)
+    sync->planar.clear();
+
+  LOG(DEBUG) << "Direct correlator: taps " << hLen << ", "
+             << (sync->planar.empty() ? "interleaved" : "planar");
+}
+
+/*
+ * Split a set of equal length sequences into back to back real and imaginary
+ * taps for the multi-sequence correlator. Keep them only if a typical search
+ * window is correlated faster than with one pass per sequence.
+ */
+static void initMultiSequence(CorrelationSequence **syncs, int num,
+                              std::vector<float> &taps, const char *name)
+{
+  size_t len = PLANAR_XOVER_LEN;
+  size_t hLen = syncs[0]->sequence->size();
+  size_t start = hLen - 1;
+  signalVector x(start + len), y(len);
+  SigProcWorkspace ws;
+
+  taps.clear();
+
+  for (int i = 1; i < num; i++) {
+    if (syncs[i]->sequence->size() != hLen)
+      return;
+  }
+
+  for (size_t i = 0; i < x.size(); i++)
+    x[i] = complex(1.0f, -1.0f);
+
+  double single = timeCorrelator([&] {
+    for (int i = 0; i < num; i++)
+      correlateDirect(x, syncs[i], y, start, len, ws);
+  });
+
+  taps.resize(2 * num * hLen);
+  for (int i = 0; i < num; i++) {
+    convert_float_planar(&taps[i * hLen], &taps[(num + i) * hLen],
+                         (const float *) syncs[i]->sequence->begin(), hLen);
+  }
+  double multi = timeCorrelator([&] {
+    correlateMulti(x, &taps[0], hLen, num, start, len, ws);
+  });
+
+  if (multi >= single)
+    taps.clear();
+
+  LOG(DEBUG) << name << " correlator: taps " << hLen << ", "
+             << (taps.empty() ? "single" : "multi") << " sequence";
+}
+
+/*
+ * Attach an FFT correlator to a sequence and measure the search window
+ * length where it beats direct convolution. Direct cost scales with the
+ * window, while each transform yields a fixed block of outputs, so a single
+ * block timing of both is enough to place the crossover. The FFT path stays
+ * disabled if it never wins.
+ */
+static bool initFFTCorrelator(CorrelationSequence *sync)
+{
+  FFTCorrelator *fft = new FFTCorrelator(*sync->sequence);
+  if (!fft->init()) {
+    delete fft;
+    return false;
+  }
+
+  size_t len = fft->len();
+  size_t start = sync->sequence->size() - 1;
+  signalVector x(start + len), y(len);
+  SigProcWorkspace ws;
+
+  for (size_t i = 0; i < x.size(); i++)
+    x[i] = complex(1.0f, -1.0f);
+
+  double direct = timeCorrelator([&] {
+    correlateDirect(x, sync, y, start, len, ws);
+  });
+  double freq = timeCorrelator([&] {
+    fft->correlate(x, y, start, len);
+  });
+
+  sync->fft = fft;
+  if (freq < direct)
+    sync->fftMinLen = (size_t) (len * freq / direct) + 1;
   else
-    return demodGmskBurst(burst, sps, amp, toa);
+    sync->fftMinLen = std::numeric_limits<size_t>::max();
+
+  LOG(DEBUG) << "FFT correlator: taps " << sync->sequence->size()
+             << ", block " << len << ", crossover " << sync->fftMinLen;
+
+  return true;
 }
 
 bool sigProcLibSetup()
 {
   generateSincTable();
+  generatePeakFilters();
   initGMSKRotationTables();
+  initEdgeRotationTables();
 
   GSMPulse1 = generateGSMPulse(1);
   GSMPulse4 = generateGSMPulse(4);
@@ -1903,6 +2955,36 @@ bool sigProcLibSetup()
     goto fail;
   }
 
+  tuneKernelShapes();
+
+  for (int i = 0; i < 8; i++) {
+    initPlanarSequence(gMidambles[i]);
+    initPlanarSequence(gEdgeMidambles[i]);
+
+    if (!initFFTCorrelator(gMidambles[i]) ||
+        !initFFTCorrelator(gEdgeMidambles[i])) {
+      LOG(ALERT) << "Failed to initialize FFT correlator";
+      goto fail;
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    initPlanarSequence(gRACHSequences[i]);
+
+    if (!initFFTCorrelator(gRACHSequences[i])) {
+      LOG(ALERT) << "Failed to initialize FFT correlator";
+      goto fail;
+    }
+  }
+
+  initMultiSequence(gRACHSequences, 3, gRACHPlanar, "RACH");
+  initMultiSequence(gMidambles, 8, gMidamblePlanar, "Midamble");
+
+  if (!generateDemodFilters()) {
+    LOG(ALERT) << "Failed to initialize demodulation filters";
+    goto fail;
+  }
+
   return true;
 
 fail:
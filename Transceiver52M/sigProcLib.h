@@ -15,6 +15,8 @@
 #ifndef SIGPROCLIB_H
 #define SIGPROCLIB_H
 
+#include <vector>
+
 #include "Vector.h"
 #include "Complex.h"
 #include "BitVector.h"
@@ -58,18 +60,28 @@ bool sigProcLibSetup();
 /** Destroy the signal processing library */
 void sigProcLibDestroy(void);
 
-/** Operate soft slicer on a soft-bit vector */
-void vectorSlicer(float *dest, const float *src, size_t len);
+struct SigProcWorkspace;
 
 /** GMSK modulate a GSM burst of bits */
 signalVector *modulateBurst(const BitVector &wBurst,
                             int guardPeriodLength,
                             int sps, bool emptyPulse = false);
 
+/** GMSK modulate a GSM burst of bits into out, resized to the burst length
+    if needed, with the intermediate stages held in ws */
+bool modulateBurst(const BitVector &wBurst, int guardPeriodLength, int sps,
+                   signalVector &out, SigProcWorkspace &ws,
+                   bool emptyPulse = false);
+
 /** 8-PSK modulate a burst of bits */
 signalVector *modulateEdgeBurst(const BitVector &bits,
                                 int sps, bool emptyPulse = false);
 
+/** 8-PSK modulate a burst of bits into out, resized to the burst length
+    if needed, with the intermediate stages held in ws */
+bool modulateEdgeBurst(const BitVector &bits, int sps, signalVector &out,
+                       SigProcWorkspace &ws, bool emptyPulse = false);
+
 /** Generate a EDGE burst with random payload - 4 SPS (625 samples) only */
 signalVector *generateEdgeBurst(int tsc);
 
@@ -97,10 +109,12 @@ void scaleVector(signalVector &x,
         Rough energy estimator.
         @param rxBurst A GSM burst.
         @param windowLength The number of burst samples used to compute burst energy
+        @param max_ampl Optional output of the largest I or Q amplitude in the burst.
         @return The average power of the received burst.
 */
 float energyDetect(const signalVector &rxBurst,
-                   unsigned windowLength);
+                   unsigned windowLength,
+                   float *max_ampl = NULL);
 
 /** Struct used to fill out parameters in detectAnyBurst(): estimated burst parameters
 @param amplitude The estimated amplitude of received TSC burst.
@@ -113,6 +127,44 @@ struct estim_burst_params {
         uint8_t tsc;
         float ci;
 };
+
+/** Burst products of the detector reused by demodAnyBurst() on the same burst
+@param dec The burst at 1 SPS as correlated by the detector.
+@param sps The oversampling of the burst dec was obtained from, zero if unset.
+@param lo First symbol of dec obtained so far.
+@param hi End of the symbols of dec obtained so far.
+*/
+struct burst_ctx {
+        signalVector dec;
+        int sps;
+        int lo;
+        int hi;
+
+        burst_ctx() : sps(0), lo(0), hi(0) {}
+};
+
+/** Scratch buffers for the intermediate stages of burst detection,
+    demodulation and modulation. Buffers grow on first use and are kept, so
+    the functions taking a workspace do not allocate once warmed up. Keep
+    one workspace per thread, it must not be used concurrently.
+*/
+struct SigProcWorkspace {
+        signalVector corr;              ///< Correlation of a search window
+        signalVector window;            ///< Zero padded filter input
+        signalVector dec;               ///< Burst at 1 SPS for demodulation
+        signalVector edge;              ///< Symbols past the end of a shifted burst
+        signalVector c0;                ///< Modulator symbols, C0 pulse
+        signalVector c1;                ///< Modulator symbols, C1 pulse
+        signalVector shaped;            ///< Modulator C1 pulse output
+        std::vector<float> planar;      ///< Split I/Q correlator buffers
+        std::vector<float> multi;       ///< Multi-sequence correlator buffers
+        std::vector<float> taps;        ///< Gathered split taps of a subset
+        struct burst_ctx ctx;           ///< Detector products without caller context
+        std::vector<struct burst_ctx> batch;        ///< Same for a frame of bursts
+        std::vector<struct burst_ctx *> batch_ctx;  ///< Pointers into batch
+
+        SigProcWorkspace();
+};
 /**
         8-PSK/GMSK/RACH burst detector
         @param burst The received GSM burst of interest
@@ -121,6 +173,8 @@ struct estim_burst_params {
         @param sps The number of samples per GSM symbol.
         @param max_toa The maximum expected time-of-arrival (in symbols).
         @param ebp The estimated parameters of the detected burst.
+        @param max_ampl Largest I or Q amplitude from energyDetect(), negative to compute it here.
+        @param ctx Storage for the detector products reused by demodAnyBurst(), may be NULL.
         @return positive value (CorrType) if threshold value is reached,
                 negative value (-SignalError) on error,
                 zero (SIGERR_NONE) if no burst is detected
@@ -131,10 +185,145 @@ int detectAnyBurst(const signalVector &burst,
                    int sps,
                    CorrType type,
                    unsigned max_toa,
-                   struct estim_burst_params *ebp);
+                   struct estim_burst_params *ebp,
+                   float max_ampl = -1.0f,
+                   struct burst_ctx *ctx = NULL);
+
+/** 8-PSK/GMSK/RACH burst detector as above, with the intermediate stages held in ws */
+int detectAnyBurst(const signalVector &burst,
+                   unsigned tsc,
+                   float threshold,
+                   int sps,
+                   CorrType type,
+                   unsigned max_toa,
+                   struct estim_burst_params *ebp,
+                   float max_ampl,
+                   struct burst_ctx *ctx,
+                   SigProcWorkspace &ws);
+
+/**
+        GMSK normal burst detector with a narrow search window
+        @param burst The received GSM burst of interest
+        @param tsc Midamble type (0..7) also known as TSC
+        @param threshold The threshold that the received burst's post-correlator SNR is compared against to determine validity.
+        @param sps The number of samples per GSM symbol.
+        @param toa The expected time-of-arrival (in symbols), e.g. of the previous burst on the channel.
+        @param margin The number of symbols searched on either side of toa.
+        @param max_toa The maximum expected time-of-arrival (in symbols), the window never exceeds that of detectAnyBurst().
+        @param ebp The estimated parameters of the detected burst.
+        @param max_ampl Largest I or Q amplitude from energyDetect(), negative to compute it here.
+        @param ctx Storage for the detector products reused by demodAnyBurst(), may be NULL.
+        @return TSC if threshold value is reached, otherwise as detectAnyBurst()
+*/
+int detectNormalBurst(const signalVector &burst,
+                      unsigned tsc,
+                      float threshold,
+                      int sps,
+                      float toa,
+                      unsigned margin,
+                      unsigned max_toa,
+                      struct estim_burst_params *ebp,
+                      float max_ampl = -1.0f,
+                      struct burst_ctx *ctx = NULL);
+
+/** GMSK normal burst detector as above, with the intermediate stages held in ws */
+int detectNormalBurst(const signalVector &burst,
+                      unsigned tsc,
+                      float threshold,
+                      int sps,
+                      float toa,
+                      unsigned margin,
+                      unsigned max_toa,
+                      struct estim_burst_params *ebp,
+                      float max_ampl,
+                      struct burst_ctx *ctx,
+                      SigProcWorkspace &ws);
+
+/**
+        GMSK normal burst detector for several midambles at once
+        @param burst The received GSM burst of interest
+        @param tsc_mask Bit mask of the midamble types (0..7) to search
+        @param threshold The threshold that the received burst's post-correlator SNR is compared against to determine validity.
+        @param sps The number of samples per GSM symbol.
+        @param max_toa The maximum expected time-of-arrival (in symbols).
+        @param ebp The estimated parameters of the best matching midamble, whose TSC is stored in ebp->tsc.
+        @param ratios Peak-to-average ratio for each of the 8 midambles, zero if not searched. May be NULL.
+        @param max_ampl Largest I or Q amplitude from energyDetect(), negative to compute it here.
+        @return TSC if threshold value is reached, otherwise as detectAnyBurst()
+*/
+int detectTscBurst(const signalVector &burst,
+                   unsigned tsc_mask,
+                   float threshold,
+                   int sps,
+                   unsigned max_toa,
+                   struct estim_burst_params *ebp,
+                   float *ratios = NULL,
+                   float max_ampl = -1.0f);
+
+/**
+        GMSK normal burst detector for the bursts of a TDMA frame
+        @param bursts The received GSM bursts of interest
+        @param num The number of bursts
+        @param tsc Midamble type (0..7) also known as TSC
+        @param threshold The threshold that the received burst's post-correlator SNR is compared against to determine validity.
+        @param sps The number of samples per GSM symbol.
+        @param max_toa The maximum expected time-of-arrival (in symbols).
+        @param ebp The estimated parameters of each burst.
+        @param max_ampl Largest I or Q amplitude of each burst from energyDetect(), negative or NULL to compute it here.
+        @param ctx Storage for the detector products of each burst reused by demodAnyBurst(), may be NULL.
+        @param rc Result of each burst, as detectAnyBurst() with type TSC.
+        @return number of detected bursts, negative value (-SignalError) on error
+*/
+int detectNormalBursts(const signalVector *const *bursts,
+                       size_t num,
+                       unsigned tsc,
+                       float threshold,
+                       int sps,
+                       unsigned max_toa,
+                       struct estim_burst_params *ebp,
+                       const float *max_ampl,
+                       struct burst_ctx *const *ctx,
+                       int *rc);
+
+/** GMSK normal burst detector for a TDMA frame as above, with the intermediate stages held in ws */
+int detectNormalBursts(const signalVector *const *bursts,
+                       size_t num,
+                       unsigned tsc,
+                       float threshold,
+                       int sps,
+                       unsigned max_toa,
+                       struct estim_burst_params *ebp,
+                       const float *max_ampl,
+                       struct burst_ctx *const *ctx,
+                       int *rc,
+                       SigProcWorkspace &ws);
 
-/** Demodulate burst basde on type and output soft bits */
+/** Demodulate burst basde on type and output soft bits, reusing the
+    products of the detection of the same burst in ctx if not NULL */
 SoftVector *demodAnyBurst(const signalVector &burst, int sps,
-                          complex amp, float toa, CorrType type);
+                          complex amp, float toa, CorrType type,
+                          struct burst_ctx *ctx = NULL);
+
+/** Demodulate burst based on type directly into TRXD soft bits
+        @param burst The burst to demodulate.
+        @param sps The samples-per-symbol of the burst.
+        @param amp The channel gain of the burst.
+        @param toa The time-of-arrival of the burst (in symbols).
+        @param type The modulation of the burst, EDGE or GMSK otherwise.
+        @param soft Output of the soft bits normalized 0..255.
+        @param len The size of soft, further bits are dropped.
+        @param ctx Products of the detection of the same burst, may be NULL.
+        @return number of soft bits written, negative value (-SignalError) on error
+*/
+int demodAnyBurst(const signalVector &burst, int sps,
+                  complex amp, float toa, CorrType type,
+                  unsigned char *soft, size_t len,
+                  struct burst_ctx *ctx = NULL);
+
+/** Demodulate burst into TRXD soft bits as above, with the intermediate stages held in ws */
+int demodAnyBurst(const signalVector &burst, int sps,
+                  complex amp, float toa, CorrType type,
+                  unsigned char *soft, size_t len,
+                  struct burst_ctx *ctx, SigProcWorkspace &ws);
 
 #endif /* SIGPROCLIB_H */
@@ -18,7 +18,7 @@
 #
 #   And defines:
 #
-#     HAVE_SSE3 / HAVE_SSE4.1
+#     HAVE_SSE3 / HAVE_SSE4.1 / HAVE_AVX2 / HAVE_AVX512
 #
 # LICENSE
 #
@@ -42,6 +42,8 @@ AC_DEFUN([AX_SSE],
 
   AM_CONDITIONAL(HAVE_SSE3, false)
   AM_CONDITIONAL(HAVE_SSE4_1, false)
+  AM_CONDITIONAL(HAVE_AVX2, false)
+  AM_CONDITIONAL(HAVE_AVX512, false)
 
   case $host_cpu in
     i[[3456]]86*|x86_64*|amd64*)
@@ -64,6 +66,28 @@ AC_DEFUN([AX_SSE],
       else
         AC_MSG_WARN([Your compiler does not support SSE4.1])
       fi
+
+      # AVX2 and AVX-512 kernels are only built into their own objects and
+      # selected at runtime, so the flags are intentionally not added to
+      # SIMD_FLAGS
+      AX_CHECK_COMPILE_FLAG([-mavx2 -mfma -mf16c], ax_cv_support_avx2_ext=yes, [])
+      if test x"$ax_cv_support_avx2_ext" = x"yes"; then
+        AC_DEFINE(HAVE_AVX2,,
+          [Support AVX2 (Advanced Vector Extensions 2), FMA and F16C instructions])
+        AM_CONDITIONAL(HAVE_AVX2, true)
+      else
+        AC_MSG_WARN([Your compiler does not support AVX2, FMA and F16C])
+      fi
+
+      AX_CHECK_COMPILE_FLAG([-mavx512f -mavx512vl -mfma],
+        ax_cv_support_avx512_ext=yes, [])
+      if test x"$ax_cv_support_avx512_ext" = x"yes"; then
+        AC_DEFINE(HAVE_AVX512,,
+          [Support AVX-512 Foundation and Vector Length instructions])
+        AM_CONDITIONAL(HAVE_AVX512, true)
+      else
+        AC_MSG_WARN([Your compiler does not support AVX-512F/VL])
+      fi
   ;;
   esac
 
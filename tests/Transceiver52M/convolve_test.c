@@ -135,6 +135,23 @@ static const struct test_data tests[] = {
 	{ 0, 0, NULL },
 };
 
+/*
+ * Odd tap counts and output spans that are not a multiple of any vector
+ * width, the reference is the base kernel run on the same input
+ */
+struct odd_shape {
+	int h_len;
+	int len;
+};
+
+static const struct odd_shape odd_shapes[] = {
+	{  5, 13 },
+	{  5, 95 },
+	{ 17, 13 },
+	{ 17, 83 },
+	{ 0, 0 },
+};
+
 
 // ---------------------------------------------------------------------------
 // Main testing logic
@@ -202,19 +219,25 @@ test_vec_release(struct test_vec *tv)
 	free(tv);
 }
 
+/* Longest output span that fits the test vectors */
+static int
+full_len(struct test_vec *tv, int h_len)
+{
+	return tv->x_len / 2 - (h_len - 1);
+}
+
 /* Run convolution */
 static int
-run_convolve(struct test_vec *tv, int h_len, enum test_type type)
+run_convolve(struct test_vec *tv, int h_len, int len, enum test_type type)
 {
 	int x_len;
-	int start, len;
+	int start;
 
 	test_vec_reset(tv, 0);
 
 	/* Compute params that fit within our test vectors */
 	x_len = tv->x_len / 2; /* float vs complex */
 	start = h_len - 1;
-	len   = x_len - start;
 
 	/* Run implementation */
 	switch (type) {
@@ -258,10 +281,153 @@ run_convolve(struct test_vec *tv, int h_len, enum test_type type)
 	return len * 2;
 }
 
+/* Run polyphase convolution with a single partition */
+static int
+run_convolve_polyphase(struct test_vec *tv, int h_len, int len)
+{
+	int x_len;
+	int start;
+	int *index, *path;
+	int i;
+
+	test_vec_reset(tv, 0);
+
+	/* Same input span as run_convolve() */
+	x_len = tv->x_len / 2; /* float vs complex */
+	start = h_len - 1;
+
+	index = malloc(len * sizeof(int));
+	path  = malloc(len * sizeof(int));
+
+	for (i = 0; i < len; i++) {
+		index[i] = start + i;
+		path[i]  = 0;
+	}
+
+	convolve_real_polyphase(
+		tv->x, x_len,
+		tv->h, h_len,
+		tv->y, tv->y_len,
+		index, path, len
+	);
+
+	free(path);
+	free(index);
+
+	return len * 2;
+}
+
+/* Run planar complex convolution on split copies of the test vectors */
+static int
+run_convolve_planar(struct test_vec *tv, int h_len, int len)
+{
+	int x_len;
+	int start;
+	float *x_re, *x_im, *h_re, *h_im, *y_re, *y_im;
+	int i;
+
+	test_vec_reset(tv, 0);
+
+	/* Same input span as run_convolve() */
+	x_len = tv->x_len / 2; /* float vs complex */
+	start = h_len - 1;
+
+	x_re = malloc(x_len * 2 * sizeof(float));
+	h_re = malloc(h_len * 2 * sizeof(float));
+	y_re = malloc(len * 2 * sizeof(float));
+	x_im = x_re + x_len;
+	h_im = h_re + h_len;
+	y_im = y_re + len;
+
+	for (i = 0; i < x_len; i++) {
+		x_re[i] = tv->x[2 * i + 0];
+		x_im[i] = tv->x[2 * i + 1];
+	}
+
+	for (i = 0; i < h_len; i++) {
+		h_re[i] = tv->h[2 * i + 0];
+		h_im[i] = tv->h[2 * i + 1];
+	}
+
+	convolve_complex_planar(
+		x_re, x_im, x_len,
+		h_re, h_im, h_len,
+		y_re, y_im, tv->y_len / 2,
+		start, len
+	);
+
+	for (i = 0; i < len; i++) {
+		tv->y[2 * i + 0] = y_re[i];
+		tv->y[2 * i + 1] = y_im[i];
+	}
+
+	free(y_re);
+	free(h_re);
+	free(x_re);
+
+	return len * 2;
+}
+
+/*
+ * Run planar convolution against three sequences at once, sequence k being
+ * the test taps scaled by k + 1. Output of sequence k is scaled back.
+ */
+static int
+run_convolve_planar_multi(struct test_vec *tv, int h_len, int len, int k)
+{
+	int x_len;
+	int start;
+	float *x_re, *x_im, *h_re, *h_im, *y_re, *y_im;
+	int i, j;
+
+	test_vec_reset(tv, 0);
+
+	x_len = tv->x_len / 2;
+	start = h_len - 1;
+
+	x_re = malloc(x_len * 2 * sizeof(float));
+	h_re = malloc(3 * h_len * 2 * sizeof(float));
+	y_re = malloc(3 * len * 2 * sizeof(float));
+	x_im = x_re + x_len;
+	h_im = h_re + 3 * h_len;
+	y_im = y_re + 3 * len;
+
+	for (i = 0; i < x_len; i++) {
+		x_re[i] = tv->x[2 * i + 0];
+		x_im[i] = tv->x[2 * i + 1];
+	}
+
+	for (j = 0; j < 3; j++) {
+		for (i = 0; i < h_len; i++) {
+			h_re[j * h_len + i] = (j + 1) * tv->h[2 * i + 0];
+			h_im[j * h_len + i] = (j + 1) * tv->h[2 * i + 1];
+		}
+	}
+
+	convolve_complex_planar_multi(
+		x_re, x_im, x_len,
+		h_re, h_im, h_len, 3,
+		y_re, y_im, len,
+		start, len
+	);
+
+	for (i = 0; i < len; i++) {
+		tv->y[2 * i + 0] = y_re[k * len + i] / (k + 1);
+		tv->y[2 * i + 1] = y_im[k * len + i] / (k + 1);
+	}
+
+	free(y_re);
+	free(h_re);
+	free(x_re);
+
+	return len * 2;
+}
+
 
 int main(int argc, char *argv[])
 {
 	struct test_vec *tv;
+	float *exp;
 	int gen_ref_mode = 0;
 	char name[80];
 	int i, j, len;
@@ -275,6 +441,7 @@ int main(int argc, char *argv[])
 		/* All *2 is to account for the facts all vectors are actually
 		 * complex and need two floats */
 	tv = test_vec_alloc(100*2, 25*2);
+	exp = malloc(tv->y_len * sizeof(float));
 
 	/* Dump all input data to make sure we work off the same input data */
 	if (!gen_ref_mode) {
@@ -293,7 +460,9 @@ int main(int argc, char *argv[])
 	{
 		for (j=0; j<(gen_ref_mode ? 1 : 2); j++)
 		{
-			len = run_convolve(tv, tests[i].h_len, tests[i].type + j);
+			len = run_convolve(tv, tests[i].h_len,
+					   full_len(tv, tests[i].h_len),
+					   tests[i].type + j);
 
 			snprintf(name, sizeof(name)-1, "y_ref_%s_%d", type_name[tests[i].type + j], tests[i].h_len);
 
@@ -311,12 +480,135 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/* Polyphase kernel must match the plain real convolution */
+	for (i=0; !gen_ref_mode && tests[i].h_len; i++)
+	{
+		if (tests[i].type != CONV_REAL_BASE)
+			continue;
+
+		len = run_convolve_polyphase(tv, tests[i].h_len,
+					     full_len(tv, tests[i].h_len));
+
+		printf("y_ref_real_polyphase_%d: %s\n",
+			tests[i].h_len,
+			compare_floats(tests[i].y_ref, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+		);
+	}
+
+	/* Planar kernel must match the interleaved complex convolution */
+	for (i=0; !gen_ref_mode && tests[i].h_len; i++)
+	{
+		if (tests[i].type != CONV_COMPLEX_BASE)
+			continue;
+
+		len = run_convolve_planar(tv, tests[i].h_len,
+					  full_len(tv, tests[i].h_len));
+
+		printf("y_ref_complex_planar_%d: %s\n",
+			tests[i].h_len,
+			compare_floats(tests[i].y_ref, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+		);
+	}
+
+	/* Every sequence of the multi-sequence kernel must match as well */
+	for (i=0; !gen_ref_mode && tests[i].h_len; i++)
+	{
+		int k, fail = 0;
+
+		if (tests[i].type != CONV_COMPLEX_BASE)
+			continue;
+
+		for (k = 0; k < 3; k++) {
+			len = run_convolve_planar_multi(tv, tests[i].h_len,
+							full_len(tv, tests[i].h_len), k);
+			fail |= compare_floats(tests[i].y_ref, tv->y, len, 1e-5f, 1e-5f);
+		}
+
+		printf("y_ref_complex_planar_multi_%d: %s\n",
+			tests[i].h_len,
+			fail ? "FAIL" : "PASS"
+		);
+	}
+
+	/* Autotuned kernels must match the reference whichever one wins */
+	for (i=0; !gen_ref_mode && tests[i].h_len; i++)
+	{
+		enum conv_kind kind = (tests[i].type == CONV_REAL_BASE) ?
+			CONV_REAL : CONV_COMPLEX;
+
+		convolve_tune(kind, tests[i].h_len, 64);
+		len = run_convolve(tv, tests[i].h_len,
+				   full_len(tv, tests[i].h_len),
+				   tests[i].type + 1);
+
+		printf("y_ref_%s_tuned_%d: %s\n",
+			conv_kind_name(kind), tests[i].h_len,
+			compare_floats(tests[i].y_ref, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+		);
+	}
+
+	/* Every kernel must handle tails and tap counts off the vector width */
+	for (i=0; !gen_ref_mode && odd_shapes[i].h_len; i++)
+	{
+		int h_len = odd_shapes[i].h_len;
+		int k, fail;
+
+		for (j=0; j<2; j++)
+		{
+			enum test_type type = j ? CONV_COMPLEX_BASE : CONV_REAL_BASE;
+			enum conv_kind kind = j ? CONV_COMPLEX : CONV_REAL;
+
+			len = run_convolve(tv, h_len, odd_shapes[i].len, type);
+			memcpy(exp, tv->y, len * sizeof(float));
+
+			len = run_convolve(tv, h_len, odd_shapes[i].len, type + 1);
+			printf("y_odd_%s_%d_%d: %s\n",
+				type_name[type + 1], h_len, odd_shapes[i].len,
+				compare_floats(exp, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+			);
+
+			if (type == CONV_REAL_BASE) {
+				len = run_convolve_polyphase(tv, h_len, odd_shapes[i].len);
+				printf("y_odd_real_polyphase_%d_%d: %s\n",
+					h_len, odd_shapes[i].len,
+					compare_floats(exp, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+				);
+			} else {
+				len = run_convolve_planar(tv, h_len, odd_shapes[i].len);
+				printf("y_odd_complex_planar_%d_%d: %s\n",
+					h_len, odd_shapes[i].len,
+					compare_floats(exp, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+				);
+
+				for (k = 0, fail = 0; k < 3; k++) {
+					len = run_convolve_planar_multi(tv, h_len,
+									odd_shapes[i].len, k);
+					fail |= compare_floats(exp, tv->y, len, 1e-5f, 1e-5f);
+				}
+				printf("y_odd_complex_planar_multi_%d_%d: %s\n",
+					h_len, odd_shapes[i].len,
+					fail ? "FAIL" : "PASS"
+				);
+			}
+
+			convolve_tune(kind, h_len, 64);
+			len = run_convolve(tv, h_len, odd_shapes[i].len, type + 1);
+			printf("y_odd_%s_tuned_%d_%d: %s\n",
+				conv_kind_name(kind), h_len, odd_shapes[i].len,
+				compare_floats(exp, tv->y, len, 1e-5f, 1e-5f) ? "FAIL" : "PASS"
+			);
+		}
+	}
+
+	convolve_init();
+
 	if (!gen_ref_mode) {
 		printf("\n");
 		printf("\n");
 	}
 
 	/* All done ! */
+	free(exp);
 	test_vec_release(tv);
 
 	return 0;
@@ -0,0 +1,362 @@
+/*
+ * Burst detection and demodulation tests
+ *
+ * SPDX-License-Identifier: LGPL-2.1+
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "sigProcLib.h"
+#include "GSMCommon.h"
+
+extern "C" {
+#include <osmocom/core/talloc.h>
+#include <osmocom/core/application.h>
+#include "convolve.h"
+#include "convert.h"
+#include "scale.h"
+#include "mult.h"
+#include "stats.h"
+#include "debug.h"
+}
+
+/* Burst of the given TSC with a fixed payload for every run */
+static signalVector *gen_burst(unsigned tsc, int sps)
+{
+	signalVector *burst;
+
+	srand(tsc + 1);
+	burst = genRandNormalBurst(tsc, sps, 0);
+	scaleVector(*burst, 1000.0f);
+
+	return burst;
+}
+
+/* Searching a mask holding the TSC must find it with the strongest peak */
+static bool test_detect(const signalVector &burst, unsigned tsc,
+			unsigned mask, int sps)
+{
+	struct estim_burst_params ebp;
+	float ratios[8];
+	int rc;
+
+	rc = detectTscBurst(burst, mask, BURST_THRESH, sps, 4, &ebp, ratios);
+	if ((rc != TSC) || (ebp.tsc != tsc))
+		return false;
+
+	for (unsigned i = 0; i < 8; i++) {
+		if (!(mask & (1 << i)) && (ratios[i] != 0.0f))
+			return false;
+		if ((i != tsc) && (ratios[i] >= ratios[tsc]))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Searching a mask without the TSC must never report it. Other midambles may
+ * still pass the threshold through cross-correlation, which has to match the
+ * single midamble detector for each of them.
+ */
+static bool test_reject(const signalVector &burst, unsigned tsc, int sps)
+{
+	struct estim_burst_params ebp, single;
+	unsigned mask = 0xff & ~(1 << tsc);
+	float ratios[8];
+	bool any = false, hit = false;
+	int rc;
+
+	rc = detectTscBurst(burst, mask, BURST_THRESH, sps, 4, &ebp, ratios);
+	if (ratios[tsc] != 0.0f)
+		return false;
+
+	for (unsigned i = 0; i < 8; i++) {
+		if (!(mask & (1 << i)))
+			continue;
+		if (detectAnyBurst(burst, i, BURST_THRESH, sps, TSC, 4,
+				   &single) <= 0)
+			continue;
+
+		any = true;
+		if ((rc > 0) && (ebp.tsc == i))
+			hit = true;
+	}
+
+	if (rc <= 0)
+		return !any;
+
+	return (rc == TSC) && (ebp.tsc != tsc) && hit;
+}
+
+/* Normal burst bits of the given TSC with a fixed payload for every run */
+static BitVector gen_bits(unsigned tsc)
+{
+	BitVector bits(148);
+
+	srand(tsc + 1);
+	for (int i = 0; i < 148; i++)
+		bits[i] = rand() % 2;
+	for (int i = 0; i < 3; i++)
+		bits[i] = bits[145 + i] = 0;
+	bits[60] = bits[87] = 0;
+	for (int i = 0; i < 26; i++)
+		bits[61 + i] = GSM::gTrainingSequence[tsc].bit(i);
+
+	return bits;
+}
+
+/*
+ * Shift a 4 SPS burst by the given number of samples, negative values
+ * advancing it, and keep every 4 / sps-th sample. The 1 SPS bursts then
+ * arrive at quarter symbol offsets too.
+ */
+static signalVector *shift_burst(const signalVector &burst, int shift, int sps)
+{
+	int step = 4 / sps, len = burst.size() / step;
+	signalVector *out = new signalVector(len);
+
+	for (int i = 0; i < len; i++) {
+		int n = i * step - shift;
+		(*out)[i] = (n >= 0) && (n < (int) burst.size()) ?
+			    burst[n] : complex(0.0f);
+	}
+
+	scaleVector(*out, 1000.0f);
+
+	return out;
+}
+
+/* Soft bits may differ by rounding between kernels and filter paths */
+static bool soft_match(const unsigned char *a, const unsigned char *b,
+		       size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (abs(a[i] - b[i]) > 1)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Demodulate at the detected TOA and compare the hard decisions against the
+ * transmitted bits. The tail bits are skipped, as they are cut off when the
+ * burst is advanced. The detector products in ctx must give the same soft
+ * bits as demodulating from scratch, which is also checked at the TOA
+ * rounded to whole symbols where they are reused at 4 SPS.
+ */
+static bool test_demod(const signalVector &burst, const BitVector &bits,
+		       unsigned tsc, int sps)
+{
+	struct estim_burst_params ebp;
+	struct burst_ctx ctx;
+	unsigned char soft[148], ref[148];
+
+	if (detectAnyBurst(burst, tsc, BURST_THRESH, sps, TSC, 4, &ebp,
+			   -1, &ctx) != TSC)
+		return false;
+
+	if ((demodAnyBurst(burst, sps, ebp.amp, ebp.toa, TSC, soft, 148,
+			   &ctx) != 148) ||
+	    (demodAnyBurst(burst, sps, ebp.amp, ebp.toa, TSC, ref, 148) != 148) ||
+	    !soft_match(soft, ref, 148))
+		return false;
+
+	for (int i = 3; i < 145; i++) {
+		if ((soft[i] > 127) != bits.bit(i))
+			return false;
+	}
+
+	if ((demodAnyBurst(burst, sps, ebp.amp, roundf(ebp.toa), TSC, soft,
+			   148, &ctx) != 148) ||
+	    (demodAnyBurst(burst, sps, ebp.amp, roundf(ebp.toa), TSC, ref,
+			   148) != 148))
+		return false;
+
+	return soft_match(soft, ref, 148);
+}
+
+/*
+ * Bits of generateEdgeBurst() after srand(seed), which draws one random
+ * symbol index per payload symbol in transmission order
+ */
+static BitVector gen_edge_bits(unsigned tsc, unsigned seed)
+{
+	BitVector bits(EDGE_BURST_NBITS);
+	int i = 0;
+
+	srand(seed);
+	for (; i < 9; i++)
+		bits[i] = 1;
+	for (; i < 9 + 174; i += 3) {
+		unsigned index = rand() % 8;
+		bits[i + 0] = (index >> 0) & 0x01;
+		bits[i + 1] = (index >> 1) & 0x01;
+		bits[i + 2] = (index >> 2) & 0x01;
+	}
+	for (int n = 0; n < 78; i++, n++)
+		bits[i] = GSM::gEdgeTrainingSequence[tsc].bit(n);
+	for (; i < 9 + 174 + 78 + 174; i += 3) {
+		unsigned index = rand() % 8;
+		bits[i + 0] = (index >> 0) & 0x01;
+		bits[i + 1] = (index >> 1) & 0x01;
+		bits[i + 2] = (index >> 2) & 0x01;
+	}
+	for (; i < EDGE_BURST_NBITS; i++)
+		bits[i] = 1;
+
+	return bits;
+}
+
+/*
+ * An 8-PSK burst on an EGPRS slot must be classified as EDGE and every one
+ * of its soft bits must decide to the transmitted bit, with and without the
+ * detector products in ctx. Both must also agree at the TOA rounded to whole
+ * symbols, where the products are reused.
+ */
+static bool test_edge(unsigned tsc)
+{
+	struct estim_burst_params ebp;
+	struct burst_ctx ctx;
+	unsigned char soft[EDGE_BURST_NBITS], ref[EDGE_BURST_NBITS];
+	BitVector bits = gen_edge_bits(tsc, tsc + 1);
+	bool pass = true;
+
+	srand(tsc + 1);
+	signalVector *burst = generateEdgeBurst(tsc);
+	scaleVector(*burst, 1000.0f);
+
+	if ((detectAnyBurst(*burst, tsc, BURST_THRESH, 4, EDGE, 4, &ebp,
+			    -1, &ctx) != EDGE) ||
+	    (demodAnyBurst(*burst, 4, ebp.amp, ebp.toa, EDGE, soft,
+			   EDGE_BURST_NBITS, &ctx) != EDGE_BURST_NBITS) ||
+	    (demodAnyBurst(*burst, 4, ebp.amp, ebp.toa, EDGE, ref,
+			   EDGE_BURST_NBITS) != EDGE_BURST_NBITS) ||
+	    !soft_match(soft, ref, EDGE_BURST_NBITS))
+		pass = false;
+
+	for (int i = 0; pass && (i < EDGE_BURST_NBITS); i++) {
+		if ((soft[i] > 127) != bits.bit(i))
+			pass = false;
+	}
+
+	if (pass &&
+	    ((demodAnyBurst(*burst, 4, ebp.amp, roundf(ebp.toa), EDGE, soft,
+			    EDGE_BURST_NBITS, &ctx) != EDGE_BURST_NBITS) ||
+	     (demodAnyBurst(*burst, 4, ebp.amp, roundf(ebp.toa), EDGE, ref,
+			    EDGE_BURST_NBITS) != EDGE_BURST_NBITS) ||
+	     !soft_match(soft, ref, EDGE_BURST_NBITS)))
+		pass = false;
+
+	delete burst;
+
+	return pass;
+}
+
+/* A GMSK burst on an EGPRS slot must be classified as such */
+static bool test_edge_gmsk(unsigned tsc)
+{
+	struct estim_burst_params ebp;
+	signalVector *burst = gen_burst(tsc, 4);
+	int rc;
+
+	rc = detectAnyBurst(*burst, tsc, BURST_THRESH, 4, EDGE, 4, &ebp);
+	delete burst;
+
+	return rc == TSC;
+}
+
+int main(int argc, char *argv[])
+{
+	struct estim_burst_params ebp;
+	const int sps_list[] = { 1, 4 };
+	/* Sample shifts for TOAs from -2.75 to 2.75 symbols at 1 SPS */
+	const int shifts1[] = { -22, -17, -13, -10, -5, 0 };
+	/* Sample shifts for TOAs from -2.88 to 3.88 symbols at 4 SPS */
+	const int shifts4[] = { -30, -22, -17, -13, -6, -3 };
+
+	void *tall_ctx = talloc_named_const(NULL, 1, "OsmoTRX context");
+	osmo_init_logging2(tall_ctx, &log_info);
+
+	convolve_init();
+	convert_init();
+	scale_init();
+	mult_init();
+	stats_init();
+
+	if (!sigProcLibSetup()) {
+		printf("sigProcLibSetup: FAIL\n");
+		return 1;
+	}
+
+	for (int s = 0; s < 2; s++) {
+		int sps = sps_list[s];
+
+		for (unsigned tsc = 0; tsc < 8; tsc++) {
+			signalVector *burst = gen_burst(tsc, sps);
+			unsigned pair = (1 << tsc) | (1 << ((tsc + 3) % 8));
+
+			printf("detect_tsc_%u_sps%d: %s\n", tsc, sps,
+			       test_detect(*burst, tsc, 0xff, sps) &&
+			       test_detect(*burst, tsc, pair, sps) &&
+			       test_detect(*burst, tsc, 1 << tsc, sps) ?
+			       "PASS" : "FAIL");
+			printf("reject_tsc_%u_sps%d: %s\n", tsc, sps,
+			       test_reject(*burst, tsc, sps) ? "PASS" : "FAIL");
+
+			delete burst;
+		}
+	}
+
+	signalVector *burst = gen_burst(0, 4);
+	printf("empty_mask: %s\n",
+	       detectTscBurst(*burst, 0, BURST_THRESH, 4, 4, &ebp) ==
+	       -SIGERR_UNSUPPORTED ? "PASS" : "FAIL");
+	delete burst;
+
+	for (int s = 0; s < 2; s++) {
+		int sps = sps_list[s];
+		const int *shifts = sps == 1 ? shifts1 : shifts4;
+
+		for (unsigned i = 0; i < 6; i++) {
+			unsigned tsc = (i + 2) % 8;
+			BitVector bits = gen_bits(tsc);
+			signalVector *mod = modulateBurst(bits, 8, 4);
+
+			burst = shift_burst(*mod, shifts[i], sps);
+			printf("demod_gmsk_shift%d_sps%d: %s\n", shifts[i], sps,
+			       test_demod(*burst, bits, tsc, sps) ?
+			       "PASS" : "FAIL");
+
+			delete burst;
+			delete mod;
+		}
+	}
+
+	for (unsigned tsc = 0; tsc < 8; tsc++) {
+		printf("edge_tsc_%u: %s\n", tsc, test_edge(tsc) ? "PASS" : "FAIL");
+		printf("edge_gmsk_tsc_%u: %s\n", tsc,
+		       test_edge_gmsk(tsc) ? "PASS" : "FAIL");
+	}
+
+	sigProcLibDestroy();
+
+	return 0;
+}